@@ -0,0 +1,428 @@
+// c_Core/archive.c
+// Binary game archive. Every ply is stored as its index in the sorted
+// legal move list of the position, so a game costs about a byte per ply
+// (or less when packed) and decoding is a replay through move.c.
+//
+// Layout, all integers little endian:
+//   header   u32 magic, u16 version, u16 coding, u64 reserved
+//   blocks   u32 games, u32 payload bytes, then per game:
+//            u16 plies, move indices (bit-packed games are byte aligned)
+//   index    per block: u64 offset, u32 first game, u32 games
+//   trailer  u64 index offset, u32 block count, u32 magic
+#include "interface.h"
+#include "archive.h"
+#include "move.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADER_SIZE  16
+#define TRAILER_SIZE 16
+#define INDEX_ENTRY  16
+#define MAX_PLIES    0xFFFF
+
+typedef struct
+{
+    uint64_t offset;
+    uint32_t first_game;
+    uint32_t games;
+} BlockIndex;
+
+typedef struct
+{
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+} ByteBuf;
+
+struct ArchiveWriter
+{
+    FILE* file;
+    int coding;
+    uint64_t offset;       // file position of the next block
+    uint32_t total_games;
+    ByteBuf block;         // payload of the block being filled
+    uint32_t block_games;
+    BlockIndex* index;
+    uint32_t blocks;
+    uint32_t index_cap;
+};
+
+struct ArchiveReader
+{
+    FILE* file;
+    int coding;
+    BlockIndex* index;
+    uint32_t blocks;
+    uint32_t total_games;
+    uint64_t index_offset; // blocks must end before this
+    uint8_t* block;        // payload of the loaded block
+    size_t block_len;
+    size_t pos;            // read position inside block
+    uint32_t cur_block;    // == blocks when nothing is loaded
+    uint32_t next_game;    // archive-wide number of the next game to read
+};
+
+// --- 64-bit file positions (long is 32 bits on Windows) ---
+static int file_seek(FILE* f, int64_t offset, int whence) {
+#ifdef _WIN32
+    return _fseeki64(f, offset, whence);
+#else
+    return fseeko(f, (off_t)offset, whence);
+#endif
+}
+
+static uint64_t file_tell(FILE* f) {
+#ifdef _WIN32
+    return (uint64_t)_ftelli64(f);
+#else
+    return (uint64_t)ftello(f);
+#endif
+}
+
+// --- Little endian helpers ---
+static void put_u16(uint8_t* p, uint32_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void put_u32(uint8_t* p, uint32_t v) { put_u16(p, v & 0xFFFF); put_u16(p + 2, v >> 16); }
+static void put_u64(uint8_t* p, uint64_t v) { put_u32(p, (uint32_t)v); put_u32(p + 4, (uint32_t)(v >> 32)); }
+static uint32_t get_u16(const uint8_t* p) { return p[0] | ((uint32_t)p[1] << 8); }
+static uint32_t get_u32(const uint8_t* p) { return get_u16(p) | (get_u16(p + 2) << 16); }
+static uint64_t get_u64(const uint8_t* p) { return get_u32(p) | ((uint64_t)get_u32(p + 4) << 32); }
+
+static int buf_reserve(ByteBuf* b, size_t extra) {
+    if (b->len + extra <= b->cap) return 1;
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra) cap *= 2;
+    uint8_t* data = (uint8_t*)realloc(b->data, cap);
+    if (!data) return 0;
+    b->data = data;
+    b->cap = cap;
+    return 1;
+}
+
+// Bits needed to store an index below 'count'
+static int index_bits(int count) {
+    int bits = 0;
+    while ((1 << bits) < count) bits++;
+    return bits;
+}
+
+// Position of 'm' in the sorted list, or -1 if it is not legal
+static int find_move(const Move* moves, int count, Move m) {
+    int key = (m.from << 8) | m.to;
+    int lo = 0, hi = count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int mid_key = (moves[mid].from << 8) | moves[mid].to;
+        if (mid_key == key) return mid;
+        if (mid_key < key) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+// ====================== Writing ======================
+
+EXPORT ArchiveWriter* archive_create(const char* path, int coding) {
+    if (!path || (coding != ARCHIVE_BYTES && coding != ARCHIVE_PACKED)) return NULL;
+
+    ArchiveWriter* w = (ArchiveWriter*)calloc(1, sizeof(ArchiveWriter));
+    if (!w) return NULL;
+    w->file = fopen(path, "wb");
+    if (!w->file) { free(w); return NULL; }
+    w->coding = coding;
+
+    uint8_t header[HEADER_SIZE] = { 0 };
+    put_u32(header, ARCHIVE_MAGIC);
+    put_u16(header + 4, ARCHIVE_VERSION);
+    put_u16(header + 6, (uint32_t)coding);
+    if (fwrite(header, 1, HEADER_SIZE, w->file) != HEADER_SIZE) {
+        fclose(w->file);
+        free(w);
+        return NULL;
+    }
+    w->offset = HEADER_SIZE;
+    return w;
+}
+
+static int flush_block(ArchiveWriter* w) {
+    if (w->block_games == 0) return 1;
+
+    if (w->blocks == w->index_cap) {
+        uint32_t cap = w->index_cap ? w->index_cap * 2 : 64;
+        BlockIndex* index = (BlockIndex*)realloc(w->index, cap * sizeof(BlockIndex));
+        if (!index) return 0;
+        w->index = index;
+        w->index_cap = cap;
+    }
+
+    uint8_t head[8];
+    put_u32(head, w->block_games);
+    put_u32(head + 4, (uint32_t)w->block.len);
+    if (fwrite(head, 1, 8, w->file) != 8) return 0;
+    if (fwrite(w->block.data, 1, w->block.len, w->file) != w->block.len) return 0;
+
+    BlockIndex* entry = &w->index[w->blocks++];
+    entry->offset = w->offset;
+    entry->first_game = w->total_games - w->block_games;
+    entry->games = w->block_games;
+
+    w->offset += 8 + w->block.len;
+    w->block.len = 0;
+    w->block_games = 0;
+    return 1;
+}
+
+EXPORT int archive_write_game(ArchiveWriter* w, const Move* moves, int plies) {
+    if (!w || plies < 0 || plies > MAX_PLIES || (plies && !moves)) return 0;
+
+    // Worst case is a byte per ply; reserve it up front
+    if (!buf_reserve(&w->block, 2 + (size_t)plies)) return 0;
+    uint8_t* out = w->block.data + w->block.len;
+    put_u16(out, (uint32_t)plies);
+    size_t len = 2;
+
+    Board board;
+    Move legal[MAX_MOVES];
+    uint32_t acc = 0;   // pending bits for ARCHIVE_PACKED
+    int acc_bits = 0;
+    init_board(&board);
+
+    for (int i = 0; i < plies; i++) {
+        int count = generate_legal_moves(&board, board.current_turn, legal);
+        int idx = find_move(legal, count, moves[i]);
+        if (idx < 0) return 0; // illegal move: the game is dropped, block untouched
+
+        if (w->coding == ARCHIVE_BYTES) {
+            out[len++] = (uint8_t)idx;
+        } else {
+            acc |= (uint32_t)idx << acc_bits;
+            acc_bits += index_bits(count);
+            while (acc_bits >= 8) {
+                out[len++] = (uint8_t)acc;
+                acc >>= 8;
+                acc_bits -= 8;
+            }
+        }
+        apply_move(&board, moves[i].from, moves[i].to);
+    }
+    if (acc_bits > 0)
+        out[len++] = (uint8_t)acc;
+
+    w->block.len += len;
+    w->block_games++;
+    w->total_games++;
+    if (w->block_games == ARCHIVE_BLOCK_GAMES)
+        return flush_block(w);
+    return 1;
+}
+
+EXPORT int archive_finish(ArchiveWriter* w) {
+    if (!w) return 0;
+    int ok = flush_block(w);
+
+    uint8_t entry[INDEX_ENTRY];
+    for (uint32_t i = 0; ok && i < w->blocks; i++) {
+        put_u64(entry, w->index[i].offset);
+        put_u32(entry + 8, w->index[i].first_game);
+        put_u32(entry + 12, w->index[i].games);
+        ok = fwrite(entry, 1, INDEX_ENTRY, w->file) == INDEX_ENTRY;
+    }
+
+    uint8_t trailer[TRAILER_SIZE];
+    put_u64(trailer, w->offset);
+    put_u32(trailer + 8, w->blocks);
+    put_u32(trailer + 12, ARCHIVE_MAGIC);
+    if (ok) ok = fwrite(trailer, 1, TRAILER_SIZE, w->file) == TRAILER_SIZE;
+
+    if (fclose(w->file) != 0) ok = 0;
+    free(w->block.data);
+    free(w->index);
+    free(w);
+    return ok;
+}
+
+// ====================== Reading ======================
+
+EXPORT void archive_close(ArchiveReader* r) {
+    if (!r) return;
+    if (r->file) fclose(r->file);
+    free(r->index);
+    free(r->block);
+    free(r);
+}
+
+EXPORT ArchiveReader* archive_open(const char* path) {
+    if (!path) return NULL;
+    ArchiveReader* r = (ArchiveReader*)calloc(1, sizeof(ArchiveReader));
+    if (!r) return NULL;
+    r->file = fopen(path, "rb");
+    if (!r->file) { free(r); return NULL; }
+
+    uint8_t header[HEADER_SIZE], trailer[TRAILER_SIZE];
+    if (fread(header, 1, HEADER_SIZE, r->file) != HEADER_SIZE ||
+        get_u32(header) != ARCHIVE_MAGIC || get_u16(header + 4) != ARCHIVE_VERSION ||
+        file_seek(r->file, -TRAILER_SIZE, SEEK_END) != 0 ||
+        fread(trailer, 1, TRAILER_SIZE, r->file) != TRAILER_SIZE ||
+        get_u32(trailer + 12) != ARCHIVE_MAGIC) {
+        archive_close(r);
+        return NULL;
+    }
+    r->coding = (int)get_u16(header + 6);
+    r->blocks = get_u32(trailer + 8);
+    if (r->coding != ARCHIVE_BYTES && r->coding != ARCHIVE_PACKED) {
+        archive_close(r);
+        return NULL;
+    }
+
+    // The index must sit between the header and the trailer and fill
+    // that gap exactly, so a damaged trailer can't ask for a huge table
+    uint64_t index_offset = get_u64(trailer);
+    uint64_t index_end = file_tell(r->file) - TRAILER_SIZE;
+    if (index_offset < HEADER_SIZE || index_offset > index_end ||
+        (index_end - index_offset) / INDEX_ENTRY != r->blocks ||
+        (index_end - index_offset) % INDEX_ENTRY != 0) {
+        archive_close(r);
+        return NULL;
+    }
+    r->index_offset = index_offset;
+
+    r->index = (BlockIndex*)calloc(r->blocks ? r->blocks : 1, sizeof(BlockIndex));
+    if (!r->index || file_seek(r->file, (int64_t)index_offset, SEEK_SET) != 0) {
+        archive_close(r);
+        return NULL;
+    }
+    uint8_t entry[INDEX_ENTRY];
+    for (uint32_t i = 0; i < r->blocks; i++) {
+        if (fread(entry, 1, INDEX_ENTRY, r->file) != INDEX_ENTRY) {
+            archive_close(r);
+            return NULL;
+        }
+        r->index[i].offset = get_u64(entry);
+        r->index[i].first_game = get_u32(entry + 8);
+        r->index[i].games = get_u32(entry + 12);
+        if (r->index[i].offset < HEADER_SIZE || r->index[i].offset > index_offset - 8) {
+            archive_close(r);
+            return NULL;
+        }
+        r->total_games = r->index[i].first_game + r->index[i].games;
+    }
+    r->cur_block = r->blocks;
+    return r;
+}
+
+EXPORT int archive_game_count(ArchiveReader* r) {
+    return r ? (int)r->total_games : 0;
+}
+
+static int load_block(ArchiveReader* r, uint32_t b) {
+    uint8_t head[8];
+    if (file_seek(r->file, (int64_t)r->index[b].offset, SEEK_SET) != 0 ||
+        fread(head, 1, 8, r->file) != 8)
+        return 0;
+
+    // The payload has to end before the index and its game count must
+    // match the index, or a damaged header could ask for a 4 GB buffer
+    uint64_t len = get_u32(head + 4);
+    if (len > r->index_offset - r->index[b].offset - 8 ||
+        get_u32(head) != r->index[b].games)
+        return 0;
+
+    if (len > r->block_len || !r->block) {
+        uint8_t* data = (uint8_t*)realloc(r->block, len ? (size_t)len : 1);
+        if (!data) return 0;
+        r->block = data;
+    }
+    if (fread(r->block, 1, (size_t)len, r->file) != len) return 0;
+
+    r->block_len = (size_t)len;
+    r->pos = 0;
+    r->cur_block = b;
+    r->next_game = r->index[b].first_game;
+    return 1;
+}
+
+// Move past one game of the loaded block without replaying it
+static int skip_game(ArchiveReader* r) {
+    if (r->pos + 2 > r->block_len) return 0;
+    int plies = (int)get_u16(r->block + r->pos);
+    r->pos += 2;
+
+    if (r->coding == ARCHIVE_BYTES) {
+        r->pos += (size_t)plies;
+    } else {
+        // Packed widths depend on the positions, so replay is unavoidable
+        r->pos -= 2;
+        return archive_read_game(r, NULL, 0, NULL) >= 0;
+    }
+    r->next_game++;
+    return r->pos <= r->block_len;
+}
+
+EXPORT int archive_seek(ArchiveReader* r, int game) {
+    if (!r || game < 0 || (uint32_t)game >= r->total_games) return 0;
+
+    // Binary search the block holding 'game'
+    uint32_t lo = 0, hi = r->blocks - 1;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi + 1) / 2;
+        if (r->index[mid].first_game <= (uint32_t)game) lo = mid;
+        else hi = mid - 1;
+    }
+    if (!load_block(r, lo)) return 0;
+    while (r->next_game < (uint32_t)game)
+        if (!skip_game(r)) return 0;
+    return 1;
+}
+
+EXPORT int archive_read_game(ArchiveReader* r, Move* moves, int max_moves, Board* final_board) {
+    if (!r) return -1;
+
+    // Step into the next block once this one is used up
+    if (r->cur_block >= r->blocks ||
+        r->next_game >= r->index[r->cur_block].first_game + r->index[r->cur_block].games) {
+        uint32_t next = (r->cur_block >= r->blocks) ? 0 : r->cur_block + 1;
+        if (next >= r->blocks || !load_block(r, next)) return -1;
+    }
+
+    const uint8_t* in = r->block;
+    size_t pos = r->pos;
+    if (pos + 2 > r->block_len) return -1;
+    int plies = (int)get_u16(in + pos);
+    pos += 2;
+
+    Board board;
+    Move legal[MAX_MOVES];
+    uint32_t acc = 0;
+    int acc_bits = 0;
+    init_board(&board);
+
+    for (int i = 0; i < plies; i++) {
+        int count = generate_legal_moves(&board, board.current_turn, legal);
+        int idx;
+
+        if (r->coding == ARCHIVE_BYTES) {
+            if (pos >= r->block_len) return -1;
+            idx = in[pos++];
+        } else {
+            int bits = index_bits(count);
+            while (acc_bits < bits) {
+                if (pos >= r->block_len) return -1;
+                acc |= (uint32_t)in[pos++] << acc_bits;
+                acc_bits += 8;
+            }
+            idx = (int)(acc & ((1u << bits) - 1));
+            acc >>= bits;
+            acc_bits -= bits;
+        }
+        if (idx >= count) return -1; // corrupt data
+
+        if (moves && i < max_moves) moves[i] = legal[idx];
+        apply_move(&board, legal[idx].from, legal[idx].to);
+    }
+
+    r->pos = pos;
+    r->next_game++;
+    if (final_board) memcpy(final_board, &board, sizeof(Board));
+    return plies;
+}
@@ -0,0 +1,21 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include "board.h"
+#include "move.h"
+
+#define ARCHIVE_MAGIC       0x4148474Bu  // "KGHA"
+#define ARCHIVE_VERSION     1
+#define ARCHIVE_BLOCK_GAMES 256          // games per block, the unit of random access
+
+// How each ply's legal-move index is stored
+typedef enum
+{
+    ARCHIVE_BYTES = 0,   // one byte per ply
+    ARCHIVE_PACKED       // ceil(log2(legal moves)) bits per ply, forced moves are free
+} ArchiveCoding;
+
+typedef struct ArchiveWriter ArchiveWriter;
+typedef struct ArchiveReader ArchiveReader;
+
+#endif
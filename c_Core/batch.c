@@ -0,0 +1,292 @@
+// c_Core/batch.c
+// Check / mate / stalemate screening over many positions at once. The
+// kernel works on bitboards of BATCH_BLOCK positions with GCC vector
+// types and is compiled twice: once for AVX2 and once for the baseline
+// instruction set. Only positions whose king has no safe square fall
+// back to the per-board code in status.c.
+#include "interface.h"
+#include "batch.h"
+#include "status.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define HAVE_AVX2_KERNEL 1
+#endif
+
+typedef uint64_t Lanes __attribute__((vector_size(BATCH_BLOCK * 8)));
+
+#define NOT_FILE_A  0xFEFEFEFEFEFEFEFEull
+#define NOT_FILE_H  0x7F7F7F7F7F7F7F7Full
+#define NOT_FILE_AB 0xFCFCFCFCFCFCFCFCull
+#define NOT_FILE_GH 0x3F3F3F3F3F3F3F3Full
+
+// The helpers are macros rather than functions: passing 64-byte vectors
+// by value trips GCC's -Wpsabi notes even when everything is inlined.
+
+// One step in a direction, dropping bits that wrap around a file edge
+#define STEP_N(b)  ((b) << 8)
+#define STEP_S(b)  ((b) >> 8)
+#define STEP_E(b)  (((b) << 1) & NOT_FILE_A)
+#define STEP_W(b)  (((b) >> 1) & NOT_FILE_H)
+#define STEP_NE(b) (((b) << 9) & NOT_FILE_A)
+#define STEP_NW(b) (((b) << 7) & NOT_FILE_H)
+#define STEP_SE(b) (((b) >> 7) & NOT_FILE_A)
+#define STEP_SW(b) (((b) >> 9) & NOT_FILE_H)
+
+// OR into 'out' the squares reached by sliding from every bit of 'from'
+// through 'empty', including the first blocker. Written out in full:
+// at -O2 GCC keeps a loop here and the AVX2 build spills every step.
+#define SLIDE(STEP, from, empty, out) do {      \
+        Lanes fill_ = (from);                   \
+        fill_ |= STEP(fill_) & (empty);         \
+        fill_ |= STEP(fill_) & (empty);         \
+        fill_ |= STEP(fill_) & (empty);         \
+        fill_ |= STEP(fill_) & (empty);         \
+        fill_ |= STEP(fill_) & (empty);         \
+        fill_ |= STEP(fill_) & (empty);         \
+        (out) |= STEP(fill_);                   \
+    } while (0)
+
+#define ROOK_ATTACKS(from, empty, out) do {     \
+        SLIDE(STEP_N, from, empty, out);        \
+        SLIDE(STEP_S, from, empty, out);        \
+        SLIDE(STEP_E, from, empty, out);        \
+        SLIDE(STEP_W, from, empty, out);        \
+    } while (0)
+
+#define BISHOP_ATTACKS(from, empty, out) do {   \
+        SLIDE(STEP_NE, from, empty, out);       \
+        SLIDE(STEP_NW, from, empty, out);       \
+        SLIDE(STEP_SE, from, empty, out);       \
+        SLIDE(STEP_SW, from, empty, out);       \
+    } while (0)
+
+#define KNIGHT_ATTACKS(b) \
+    (((STEP_E(b) | STEP_W(b)) << 16) | ((STEP_E(b) | STEP_W(b)) >> 16) | \
+     (((((b) << 2) & NOT_FILE_AB) | (((b) >> 2) & NOT_FILE_GH)) << 8) |   \
+     (((((b) << 2) & NOT_FILE_AB) | (((b) >> 2) & NOT_FILE_GH)) >> 8))
+
+#define KING_ATTACKS(b) \
+    ((((b) | STEP_E(b) | STEP_W(b)) << 8) | (((b) | STEP_E(b) | STEP_W(b)) >> 8) | \
+     STEP_E(b) | STEP_W(b))
+
+#define KERNEL_INLINE static inline __attribute__((always_inline))
+
+KERNEL_INLINE void check_blocks(const BoardBatch* batch, unsigned char* flags) {
+    for (int i = 0; i < batch->count; i += BATCH_BLOCK) {
+        // Named loads keep every plane in a register; an array of
+        // Lanes gets spilled and reloaded at a different width
+#define LOAD(plane) ({ Lanes v_; memcpy(&v_, (plane) + i, sizeof(Lanes)); v_; })
+        Lanes black = LOAD(batch->black_to_move);
+        Lanes white = ~black;
+        Lanes w_pawn = LOAD(batch->planes[WHITE][PAWN - 1]);
+        Lanes w_knight = LOAD(batch->planes[WHITE][KNIGHT - 1]);
+        Lanes w_bishop = LOAD(batch->planes[WHITE][BISHOP - 1]);
+        Lanes w_rook = LOAD(batch->planes[WHITE][ROOK - 1]);
+        Lanes w_queen = LOAD(batch->planes[WHITE][QUEEN - 1]);
+        Lanes w_king = LOAD(batch->planes[WHITE][KING - 1]);
+        Lanes b_pawn = LOAD(batch->planes[BLACK][PAWN - 1]);
+        Lanes b_knight = LOAD(batch->planes[BLACK][KNIGHT - 1]);
+        Lanes b_bishop = LOAD(batch->planes[BLACK][BISHOP - 1]);
+        Lanes b_rook = LOAD(batch->planes[BLACK][ROOK - 1]);
+        Lanes b_queen = LOAD(batch->planes[BLACK][QUEEN - 1]);
+        Lanes b_king = LOAD(batch->planes[BLACK][KING - 1]);
+#undef LOAD
+        Lanes w_all = w_pawn | w_knight | w_bishop | w_rook | w_queen | w_king;
+        Lanes b_all = b_pawn | b_knight | b_bishop | b_rook | b_queen | b_king;
+
+        // Pick "own" and "enemy" per lane from the side to move
+#define PICK(for_white, for_black) (((for_white) & white) | ((for_black) & black))
+        Lanes king = PICK(w_king, b_king);
+        Lanes own = PICK(w_all, b_all);
+        Lanes empty = ~(w_all | b_all);
+        Lanes e_pawn = PICK(b_pawn, w_pawn);
+        Lanes e_knight = PICK(b_knight, w_knight);
+        Lanes e_king = PICK(b_king, w_king);
+        Lanes e_rook = PICK(b_rook | b_queen, w_rook | w_queen);
+        Lanes e_bishop = PICK(b_bishop | b_queen, w_bishop | w_queen);
+#undef PICK
+
+        // Enemy pawns capture towards our side of the board
+        Lanes e_pawn_att = ((STEP_NE(e_pawn) | STEP_NW(e_pawn)) & black) |
+                           ((STEP_SE(e_pawn) | STEP_SW(e_pawn)) & white);
+
+        // Check: look outward from our king as every piece type
+        Lanes rook_rays = { 0 }, bishop_rays = { 0 };
+        ROOK_ATTACKS(king, empty, rook_rays);
+        BISHOP_ATTACKS(king, empty, bishop_rays);
+        Lanes check = (e_pawn_att & king) | (KNIGHT_ATTACKS(king) & e_knight) |
+                      (rook_rays & e_rook) | (bishop_rays & e_bishop);
+
+        // Enemy attack map with our king lifted, so it cannot step back
+        // along a slider's line
+        Lanes through = empty | king;
+        Lanes attacked = e_pawn_att | KNIGHT_ATTACKS(e_knight) | KING_ATTACKS(e_king);
+        ROOK_ATTACKS(e_rook, through, attacked);
+        BISHOP_ATTACKS(e_bishop, through, attacked);
+        Lanes escape = KING_ATTACKS(king) & ~own & ~attacked;
+
+        for (int j = 0; j < BATCH_BLOCK; j++) {
+            flags[i + j] = (unsigned char)((check[j] ? BATCH_CHECK : 0) |
+                                           (escape[j] ? BATCH_KING_ESCAPE : 0));
+        }
+    }
+}
+
+static void kernel_generic(const BoardBatch* batch, unsigned char* flags) {
+    check_blocks(batch, flags);
+}
+
+#ifdef HAVE_AVX2_KERNEL
+__attribute__((target("avx2")))
+static void kernel_avx2(const BoardBatch* batch, unsigned char* flags) {
+    check_blocks(batch, flags);
+}
+#endif
+
+EXPORT BoardBatch* batch_create(int capacity) {
+    if (capacity <= 0) return NULL;
+    capacity = (capacity + BATCH_BLOCK - 1) / BATCH_BLOCK * BATCH_BLOCK;
+
+    BoardBatch* batch = (BoardBatch*)calloc(1, sizeof(BoardBatch));
+    if (!batch) return NULL;
+
+    // One allocation: 12 piece planes followed by the side-to-move plane
+    uint64_t* data = (uint64_t*)calloc((size_t)capacity * 13, sizeof(uint64_t));
+    if (!data) { free(batch); return NULL; }
+
+    for (int c = 0; c < 2; c++)
+        for (int t = 0; t < 6; t++)
+            batch->planes[c][t] = data + (size_t)(c * 6 + t) * capacity;
+    batch->black_to_move = data + (size_t)12 * capacity;
+    batch->capacity = capacity;
+    return batch;
+}
+
+EXPORT void batch_free(BoardBatch* batch) {
+    if (!batch) return;
+    free(batch->planes[0][0]);
+    free(batch);
+}
+
+// View letter -> 1 + color * 6 + (type - 1), 0 for anything else
+static const unsigned char view_plane[256] = {
+    ['P'] = 1, ['N'] = 2, ['B'] = 3, ['R'] = 4, ['Q'] = 5,  ['K'] = 6,
+    ['p'] = 7, ['n'] = 8, ['b'] = 9, ['r'] = 10, ['q'] = 11, ['k'] = 12,
+};
+
+EXPORT int batch_load(BoardBatch* batch, const Board* boards, int n) {
+    if (!batch || !boards || n < 0) return 0;
+    if (n > batch->capacity) n = batch->capacity;
+
+    // Clear the padding lanes of the last block so they read as empty boards
+    int used = (n + BATCH_BLOCK - 1) / BATCH_BLOCK * BATCH_BLOCK;
+    for (int c = 0; c < 2; c++)
+        for (int t = 0; t < 6; t++)
+            memset(batch->planes[c][t] + n, 0, (size_t)(used - n) * sizeof(uint64_t));
+
+    // Read the packed view rather than the 0x88 squares: 64 bytes per
+    // board, each byte indexing its plane directly so the loop has no
+    // branches. Slot 0 soaks up empty squares, and four accumulator sets
+    // keep runs of the same plane from chaining through memory. Boards
+    // are ~1.6 KB apart, so fetch the view a few boards ahead.
+    for (int i = 0; i < n; i++) {
+        const Board* b = &boards[i];
+        __builtin_prefetch(boards[i + 8 < n ? i + 8 : i].view);
+        uint64_t bits[4][13] = { { 0 } };
+        for (int sq = 0; sq < 64; sq += 4) {
+            bits[0][view_plane[(unsigned char)b->view[sq]]]     |= 1ull << sq;
+            bits[1][view_plane[(unsigned char)b->view[sq + 1]]] |= 2ull << sq;
+            bits[2][view_plane[(unsigned char)b->view[sq + 2]]] |= 4ull << sq;
+            bits[3][view_plane[(unsigned char)b->view[sq + 3]]] |= 8ull << sq;
+        }
+
+        for (int c = 0; c < 2; c++)
+            for (int t = 0; t < 6; t++) {
+                int p = 1 + c * 6 + t;
+                batch->planes[c][t][i] = bits[0][p] | bits[1][p] | bits[2][p] | bits[3][p];
+            }
+        batch->black_to_move[i] = (b->current_turn == BLACK) ? ~0ull : 0;
+    }
+    for (int i = n; i < used; i++)
+        batch->black_to_move[i] = 0;
+
+    batch->count = n;
+    return n;
+}
+
+EXPORT void batch_get_board(BoardBatch* batch, int index, Board* out) {
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        out->squares[i].type = EMPTY;
+        out->squares[i].color = NO_COLOR;
+    }
+    for (int c = 0; c < 2; c++) {
+        for (int t = 0; t < 6; t++) {
+            uint64_t bits = batch->planes[c][t][index];
+            while (bits) {
+                int bit = __builtin_ctzll(bits);
+                int sq = ((bit >> 3) << 4) | (bit & 7);
+                out->squares[sq].type = (PieceType)(t + 1);
+                out->squares[sq].color = (Color)c;
+                bits &= bits - 1;
+            }
+        }
+    }
+    out->current_turn = batch->black_to_move[index] ? BLACK : WHITE;
+    out->generation = 0;
+    refresh_board(out);
+}
+
+EXPORT int batch_check(BoardBatch* batch, unsigned char* flags, int kernel) {
+    if (!batch || !flags) return -1;
+
+    // flags must cover the padded block, so kernels write into scratch
+    unsigned char tail[BATCH_BLOCK];
+    int whole = batch->count / BATCH_BLOCK * BATCH_BLOCK;
+    BoardBatch head = *batch;
+    head.count = whole;
+
+#ifdef HAVE_AVX2_KERNEL
+    // An explicit AVX2 request on a CPU without it also falls back,
+    // rather than dying on an illegal instruction
+    if (kernel != BATCH_KERNEL_GENERIC)
+        kernel = __builtin_cpu_supports("avx2") ? BATCH_KERNEL_AVX2 : BATCH_KERNEL_GENERIC;
+    void (*run)(const BoardBatch*, unsigned char*) =
+        (kernel == BATCH_KERNEL_AVX2) ? kernel_avx2 : kernel_generic;
+#else
+    kernel = BATCH_KERNEL_GENERIC;
+    void (*run)(const BoardBatch*, unsigned char*) = kernel_generic;
+#endif
+
+    run(&head, flags);
+    if (whole < batch->count) {
+        BoardBatch rest = *batch;
+        for (int c = 0; c < 2; c++)
+            for (int t = 0; t < 6; t++)
+                rest.planes[c][t] += whole;
+        rest.black_to_move += whole;
+        rest.count = BATCH_BLOCK;
+        run(&rest, tail);
+        memcpy(flags + whole, tail, (size_t)(batch->count - whole));
+    }
+    return kernel;
+}
+
+EXPORT void batch_classify(BoardBatch* batch, unsigned char* flags) {
+    if (batch_check(batch, flags, BATCH_KERNEL_AUTO) < 0) return;
+
+    for (int i = 0; i < batch->count; i++) {
+        if (flags[i] & BATCH_KING_ESCAPE) continue;
+
+        // King is boxed in: only full move generation can tell
+        Board board;
+        batch_get_board(batch, i, &board);
+        int color = board.current_turn;
+        if (flags[i] & BATCH_CHECK) {
+            if (is_checkmate(&board, color)) flags[i] |= BATCH_CHECKMATE;
+        } else if (is_stalemate(&board, color)) {
+            flags[i] |= BATCH_STALEMATE;
+        }
+    }
+}
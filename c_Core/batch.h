@@ -0,0 +1,33 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "board.h"
+#include <stdint.h>
+
+#define BATCH_BLOCK 8   // positions per kernel step (two AVX2 registers per plane)
+
+// Per-position result bits of batch_check / batch_classify
+#define BATCH_CHECK       1
+#define BATCH_CHECKMATE   2
+#define BATCH_STALEMATE   4
+#define BATCH_KING_ESCAPE 8   // king has a safe square: neither mate nor stalemate
+
+// Which check kernel batch_check runs
+typedef enum
+{
+    BATCH_KERNEL_AUTO = 0,   // AVX2 when the CPU has it
+    BATCH_KERNEL_GENERIC,    // same code built for the baseline instruction set
+    BATCH_KERNEL_AVX2
+} BatchKernel;
+
+// N positions in structure-of-arrays form: one bitboard (bit = rank*8+file)
+// per color and piece type, each plane a contiguous array over positions
+typedef struct
+{
+    int count;                 // positions loaded
+    int capacity;              // rounded up to a multiple of BATCH_BLOCK
+    uint64_t* planes[2][6];    // [Color][PieceType - 1][position]
+    uint64_t* black_to_move;   // all ones where black moves, else zero
+} BoardBatch;
+
+#endif
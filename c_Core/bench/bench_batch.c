@@ -0,0 +1,154 @@
+// c_Core/bench/bench_batch.c
+// Compares the BoardBatch check kernels with the per-board scalar path.
+// Positions come from random games so checks, mates and stalemates show
+// up in roughly natural proportions.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "interface.h"
+#include "move.h"
+#include "status.h"
+
+#define POSITIONS 50000
+#define ROUNDS    20
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void report(const char *name, double secs) {
+    printf("%-28s %8.1f ns/position\n", name, secs * 1e9 / ((double)POSITIONS * ROUNDS));
+}
+
+// Positions whose bits under 'mask' differ from the scalar reference
+static int mismatches(const unsigned char *flags, const unsigned char *expected, int mask) {
+    int bad = 0;
+    for (int i = 0; i < POSITIONS; i++)
+        bad += (flags[i] & mask) != (expected[i] & mask);
+    return bad;
+}
+
+int main(void)
+{
+    Board *boards = (Board *)malloc(sizeof(Board) * POSITIONS);
+    unsigned char *flags = (unsigned char *)malloc(POSITIONS);
+    unsigned char *expected = (unsigned char *)malloc(POSITIONS);
+    BoardBatch *batch = batch_create(POSITIONS);
+    if (!boards || !flags || !expected || !batch)
+    {
+        printf("Out of memory.\n");
+        return 1;
+    }
+
+    srand(12345);
+    int n = 0;
+    while (n < POSITIONS)
+    {
+        Board b;
+        init_board(&b);
+        for (int ply = 0; ply < 300 && n < POSITIONS; ply++)
+        {
+            Move moves[MAX_MOVES];
+            memcpy(&boards[n++], &b, sizeof(Board));
+            int count = generate_legal_moves(&b, b.current_turn, moves);
+            if (count == 0)
+                break;
+            Move m = moves[rand() % count];
+            apply_move(&b, m.from, m.to);
+        }
+    }
+
+    // Scalar: is_check only reads what refresh_board cached, so time the
+    // king safety scan that produces it
+    long checks = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        for (int i = 0; i < POSITIONS; i++)
+        {
+            KingSafety ks;
+            compute_king_safety(&boards[i], boards[i].current_turn, &ks);
+            checks += ks.checkers > 0;
+        }
+    }
+    report("scalar compute_king_safety", seconds_since(start));
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        for (int i = 0; i < POSITIONS; i++)
+        {
+            int color = boards[i].current_turn;
+            expected[i] = is_check(&boards[i], color) ? BATCH_CHECK : 0;
+            if (is_checkmate(&boards[i], color))
+                expected[i] |= BATCH_CHECKMATE;
+            else if (is_stalemate(&boards[i], color))
+                expected[i] |= BATCH_STALEMATE;
+        }
+    }
+    report("scalar check/mate/stalemate", seconds_since(start));
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        batch_load(batch, boards, POSITIONS);
+    report("batch_load", seconds_since(start));
+
+    // Batch timings include the load, since real callers pay for both
+    int kernels[2] = { BATCH_KERNEL_GENERIC, BATCH_KERNEL_AVX2 };
+    const char *names[2] = { "load + check (generic)", "load + check (avx2)" };
+    for (int k = 0; k < 2; k++)
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        if (kernels[k] == BATCH_KERNEL_AVX2 && !__builtin_cpu_supports("avx2"))
+        {
+            printf("%-28s  skipped, no AVX2 on this CPU\n", names[k]);
+            continue;
+        }
+#else
+        if (kernels[k] == BATCH_KERNEL_AVX2)
+            continue;
+#endif
+        start = clock();
+        for (int r = 0; r < ROUNDS; r++)
+        {
+            batch_load(batch, boards, POSITIONS);
+            batch_check(batch, flags, kernels[k]);
+        }
+        report(names[k], seconds_since(start));
+
+        int bad = mismatches(flags, expected, BATCH_CHECK);
+        if (bad)
+            printf("MISMATCH: %d positions disagree with is_check\n", bad);
+    }
+
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        batch_load(batch, boards, POSITIONS);
+        batch_classify(batch, flags);
+    }
+    report("load + classify", seconds_since(start));
+
+    int bad = mismatches(flags, expected, BATCH_CHECK | BATCH_CHECKMATE | BATCH_STALEMATE);
+    if (bad)
+        printf("MISMATCH: %d positions disagree with status.c\n", bad);
+
+    int mates = 0, stalemates = 0, escapes = 0;
+    for (int i = 0; i < POSITIONS; i++)
+    {
+        mates += (expected[i] & BATCH_CHECKMATE) != 0;
+        stalemates += (expected[i] & BATCH_STALEMATE) != 0;
+        escapes += (flags[i] & BATCH_KING_ESCAPE) != 0;
+    }
+    printf("\n%d positions: %ld in check, %d mated, %d stalemated\n",
+           POSITIONS, checks / ROUNDS, mates, stalemates);
+    printf("king has a safe square in %d (%.1f%%), the rest go to status.c\n",
+           escapes, 100.0 * escapes / POSITIONS);
+
+    batch_free(batch);
+    free(expected);
+    free(flags);
+    free(boards);
+    return 0;
+}
@@ -0,0 +1,21 @@
+@echo off
+cd /d "%~dp0"
+
+echo.
+echo === Building bench_batch.exe ===
+echo.
+
+gcc -o bench_batch.exe bench_batch.c ^
+    ..\archive.c ..\batch.c ..\board.c ..\cache.c ..\engine.c ^
+    ..\game.c ..\interface.c ..\mate.c ..\move.c ..\status.c ^
+    -I.. -O2 -Wall -pthread -static
+
+if %ERRORLEVEL% EQU 0 (
+    echo.
+    bench_batch.exe
+) else (
+    echo.
+    echo BUILD FAILED
+)
+echo.
+pause
@@ -1,5 +1,7 @@
 #include "board.h"
+#include "status.h"
 #include <stdio.h>
+#include <string.h>
 
 bool on_board(int square) {
     return !(square & 0x88);
@@ -33,6 +35,55 @@ void init_board(Board *board) {
     }
 
     board->current_turn = WHITE;
+    board->generation = 0;
+    refresh_board(board);
+}
+
+void refresh_board(Board *board) {
+    int idx = 0;
+    for (int rank = 0; rank < 8; rank++) {
+        for (int file = 0; file < 8; file++) {
+            Piece p = board->squares[(rank << 4) + file];
+            char c = '.';
+
+            if (p.type != EMPTY) {
+                char piece_chars[] = " PNBRQK";
+                c = piece_chars[p.type];
+                if (p.color == BLACK)
+                    c += 32; // lowercase for black pieces
+            }
+            board->view[idx++] = c;
+        }
+    }
+    compute_king_safety(board, WHITE, &board->safety[WHITE]);
+    compute_king_safety(board, BLACK, &board->safety[BLACK]);
+    board->generation++;
+}
+
+void load_snapshot(Board *board, const Board *snapshot) {
+    unsigned int generation = board->generation;
+    memcpy(board, snapshot, sizeof(Board));
+    board->generation = generation;
+    refresh_board(board);
+}
+
+// splitmix64 finaliser: turns a small index into a well mixed key
+static uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t position_key(Board *board) {
+    uint64_t key = (board->current_turn == BLACK) ? mix64(0xFFFF) : 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        if (!on_board(i)) continue;
+        Piece p = board->squares[i];
+        if (p.type == EMPTY) continue;
+        key ^= mix64(((uint64_t)i << 4) | ((uint64_t)p.type << 1) | (uint64_t)p.color);
+    }
+    return key;
 }
 
 void print_board(Board *board) {
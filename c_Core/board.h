@@ -2,6 +2,7 @@
 #define BOARD_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #define BOARD_SIZE 128
 
@@ -29,15 +30,40 @@ typedef struct
     Color color;
 } Piece;
 
+// Check and pin data for one side's king, rebuilt by refresh_board so
+// move validation can test masks instead of replaying moves
+typedef struct
+{
+    int king_sq;                        // -1 if the king is missing
+    int checkers;                       // number of pieces giving check
+    unsigned char block[BOARD_SIZE];    // 1 where a move captures or blocks a single checker
+    unsigned char pin_ray[BOARD_SIZE];  // ray id (1..8) from the king to each pinner, inclusive
+} KingSafety;
+
 typedef struct
 {
     Piece squares[BOARD_SIZE]; // 0x88 board
     Color current_turn;
+    char view[64];             // packed a1..h8 piece letters, mirrors squares
+    unsigned int generation;   // bumped every time squares change
+    KingSafety safety[2];      // indexed by Color, see compute_king_safety
 } Board;
 
 // Initialize the board to starting position
 void init_board(Board *board);
 
+// Rebuild the packed view and king safety, and bump the generation,
+// after squares change
+void refresh_board(Board *board);
+
+// Copy a saved position into 'board' in place, keeping its generation
+// counter rising so views over the live board stay valid
+void load_snapshot(Board *board, const Board *snapshot);
+
+// 64-bit Zobrist-style key of squares and side to move. The constants
+// are fixed, so keys are stable across runs and processes.
+uint64_t position_key(Board *board);
+
 // Print board to console for debugging
 void print_board(Board *board);
 
@@ -8,7 +8,7 @@ echo.
 if not exist "..\python_GUI" mkdir "..\python_GUI"
 
 rem --- FULL STATIC: No external DLLs ---
-gcc -shared -o "..\python_GUI\chess.dll" *.c -O2 -Wall ^
+gcc -shared -o "..\python_GUI\chess.dll" *.c -O2 -Wall -pthread ^
     -static-libgcc -static-libstdc++ ^
     -static ^
     -Wl,--subsystem,windows
@@ -0,0 +1,324 @@
+// c_Core/cache.c
+// Persistent analysis cache: a memory-mapped open addressing table that
+// several processes can read and write at once. Each slot is guarded by
+// a sequence counter (odd while a writer owns it), so readers never
+// block and never see a half written entry.
+#include "interface.h"
+#include "cache.h"
+#include "engine.h"
+#include "move.h"
+#include "status.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define SPIN_LIMIT    1024  // readers skip a slot whose writer takes longer
+#define STALE_SECONDS 2     // writers reclaim a slot locked at least this long
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    uint8_t  reserved[48];
+} CacheHeader;
+
+typedef struct
+{
+    uint32_t seq;         // even: stable, odd: being written
+    uint32_t stamp;       // when an odd seq was first seen, 0 if not yet
+    uint64_t key;         // 0 marks an empty slot
+    AnalysisEntry entry;
+} CacheSlot;
+
+struct AnalysisCache
+{
+    uint8_t* base;
+    size_t size;
+    CacheSlot* slots;
+    uint32_t mask;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+};
+
+// Key 0 means "empty", so nudge the one position that hashes to it
+static uint64_t slot_key(Board* board) {
+    uint64_t key = position_key(board);
+    return key ? key : 1;
+}
+
+static void unmap(AnalysisCache* cache) {
+#ifdef _WIN32
+    if (cache->base) UnmapViewOfFile(cache->base);
+    if (cache->mapping) CloseHandle(cache->mapping);
+    if (cache->file != INVALID_HANDLE_VALUE) CloseHandle(cache->file);
+#else
+    if (cache->base) munmap(cache->base, cache->size);
+    if (cache->fd >= 0) close(cache->fd);
+#endif
+}
+
+static int open_file(AnalysisCache* cache, const char* path) {
+#ifdef _WIN32
+    cache->file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    return cache->file != INVALID_HANDLE_VALUE;
+#else
+    cache->fd = open(path, O_RDWR | O_CREAT, 0644);
+    return cache->fd >= 0;
+#endif
+}
+
+// Serialises creation between processes. On Windows the locked byte
+// sits far past the data, since locks there also block plain reads.
+static int lock_file(AnalysisCache* cache, int lock) {
+#ifdef _WIN32
+    OVERLAPPED ov;
+    memset(&ov, 0, sizeof(ov));
+    ov.OffsetHigh = 0x7FFFFFFF;
+    return lock ? LockFileEx(cache->file, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &ov) != 0
+                : UnlockFileEx(cache->file, 0, 1, 0, &ov) != 0;
+#else
+    return flock(cache->fd, lock ? LOCK_EX : LOCK_UN) == 0;
+#endif
+}
+
+// Size of the file, growing it to 'size' first if it is still empty.
+// Call with the lock held; returns 0 on errors.
+static size_t prepare_file(AnalysisCache* cache, size_t size) {
+#ifdef _WIN32
+    LARGE_INTEGER current;
+    if (!GetFileSizeEx(cache->file, &current)) return 0;
+    if (current.QuadPart == 0) {
+        LARGE_INTEGER end;
+        end.QuadPart = (LONGLONG)size;
+        if (!SetFilePointerEx(cache->file, end, NULL, FILE_BEGIN) ||
+            !SetEndOfFile(cache->file) ||
+            !GetFileSizeEx(cache->file, &current))
+            return 0;
+    }
+    return (size_t)current.QuadPart;
+#else
+    struct stat st;
+    if (fstat(cache->fd, &st) != 0) return 0;
+    if (st.st_size == 0) {
+        if (ftruncate(cache->fd, (off_t)size) != 0 || fstat(cache->fd, &st) != 0)
+            return 0;
+    }
+    return (size_t)st.st_size;
+#endif
+}
+
+static int map_file(AnalysisCache* cache, size_t size) {
+#ifdef _WIN32
+    cache->mapping = CreateFileMappingA(cache->file, NULL, PAGE_READWRITE, 0, 0, NULL);
+    if (!cache->mapping) return 0;
+
+    cache->base = (uint8_t*)MapViewOfFile(cache->mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!cache->base) return 0;
+#else
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, cache->fd, 0);
+    if (base == MAP_FAILED) return 0;
+    cache->base = (uint8_t*)base;
+#endif
+    cache->size = size;
+    return 1;
+}
+
+// Stamp a fresh file or validate an existing one; call with the lock held
+static int setup_header(AnalysisCache* cache) {
+    CacheHeader* header = (CacheHeader*)cache->base;
+    if (header->magic == 0) {
+        uint32_t count = 1;
+        while ((size_t)count * 2 * sizeof(CacheSlot) <= cache->size - sizeof(CacheHeader))
+            count <<= 1;
+        header->version = CACHE_VERSION;
+        header->slot_count = count;
+        header->slot_size = sizeof(CacheSlot);
+        __atomic_store_n(&header->magic, CACHE_MAGIC, __ATOMIC_RELEASE);
+        return 1;
+    }
+    // Not one of ours, or from an incompatible build
+    return header->magic == CACHE_MAGIC && header->version == CACHE_VERSION &&
+           header->slot_size == sizeof(CacheSlot) && header->slot_count > 0 &&
+           (header->slot_count & (header->slot_count - 1)) == 0 &&
+           sizeof(CacheHeader) + (size_t)header->slot_count * sizeof(CacheSlot) <= cache->size;
+}
+
+EXPORT AnalysisCache* cache_open(const char* path, unsigned int slots) {
+    if (!path) return NULL;
+
+    // Round up to a power of two so probing can mask instead of divide
+    uint32_t count = 1;
+    if (slots == 0) slots = CACHE_DEFAULT_SLOTS;
+    while (count < slots && count < 0x80000000u) count <<= 1;
+
+    AnalysisCache* cache = (AnalysisCache*)calloc(1, sizeof(AnalysisCache));
+    if (!cache) return NULL;
+#ifdef _WIN32
+    cache->file = INVALID_HANDLE_VALUE;
+#else
+    cache->fd = -1;
+#endif
+
+    // Size, map and stamp the file under an exclusive lock: the first
+    // opener creates it, everyone else maps whatever size it really has
+    int ok = open_file(cache, path) && lock_file(cache, 1);
+    if (ok) {
+        size_t size = prepare_file(cache, sizeof(CacheHeader) + (size_t)count * sizeof(CacheSlot));
+        ok = size >= sizeof(CacheHeader) + sizeof(CacheSlot) &&
+             map_file(cache, size) && setup_header(cache);
+        if (!lock_file(cache, 0)) ok = 0;
+    }
+    if (!ok) {
+        unmap(cache);
+        free(cache);
+        return NULL;
+    }
+
+    CacheHeader* header = (CacheHeader*)cache->base;
+    cache->slots = (CacheSlot*)(cache->base + sizeof(CacheHeader));
+    cache->mask = header->slot_count - 1;
+    return cache;
+}
+
+EXPORT void cache_close(AnalysisCache* cache) {
+    if (!cache) return;
+    unmap(cache);
+    free(cache);
+}
+
+// Consistent snapshot of a slot; returns 0 if a writer held it too long
+static int read_slot(CacheSlot* slot, uint64_t* key, AnalysisEntry* entry) {
+    for (int spin = 0; spin < SPIN_LIMIT; spin++) {
+        uint32_t before = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (before & 1) continue;
+
+        *key = __atomic_load_n(&slot->key, __ATOMIC_RELAXED);
+        memcpy(entry, &slot->entry, sizeof(AnalysisEntry));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == before)
+            return 1;
+    }
+    return 0;
+}
+
+EXPORT int cache_lookup(AnalysisCache* cache, Board* board, AnalysisEntry* out) {
+    if (!cache || !board) return 0;
+    uint64_t key = slot_key(board);
+
+    for (uint32_t i = 0; i < CACHE_PROBES; i++) {
+        CacheSlot* slot = &cache->slots[(key + i) & cache->mask];
+        uint64_t found;
+        AnalysisEntry entry;
+
+        if (!read_slot(slot, &found, &entry)) continue;
+        if (found == 0) return 0; // keys are never deleted, so the chain ends here
+        if (found == key) {
+            if (out) *out = entry;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Coarse wall clock for stamps; never 0, which means "not stamped"
+static uint32_t stamp_now(void) {
+    uint32_t now = (uint32_t)time(NULL);
+    return now ? now : 1;
+}
+
+// A writer that dies between locking and releasing a slot leaves its seq
+// odd in the file for good. The first writer to find it locked stamps it;
+// one that still finds the same seq STALE_SECONDS later takes the slot
+// over, keeping seq odd. Returns 1 if the caller now owns the slot.
+static int reclaim_slot(CacheSlot* slot, uint32_t seq) {
+    uint32_t now = stamp_now();
+    uint32_t stamp = __atomic_load_n(&slot->stamp, __ATOMIC_RELAXED);
+    if (stamp == 0) {
+        __atomic_compare_exchange_n(&slot->stamp, &stamp, now, 0,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        return 0;
+    }
+    if (now - stamp < STALE_SECONDS) return 0;
+    return __atomic_compare_exchange_n(&slot->seq, &seq, seq + 2, 0,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+EXPORT int cache_store(AnalysisCache* cache, Board* board, const AnalysisEntry* entry) {
+    if (!cache || !board || !entry) return 0;
+    uint64_t key = slot_key(board);
+
+    // Prefer our own slot or the first empty one; a full window
+    // overwrites the home slot
+    for (uint32_t i = 0; i <= CACHE_PROBES; i++) {
+        int replace = (i == CACHE_PROBES);
+        CacheSlot* slot = &cache->slots[(key + (replace ? 0 : i)) & cache->mask];
+
+        uint64_t current = __atomic_load_n(&slot->key, __ATOMIC_RELAXED);
+        if (!replace && current != 0 && current != key) continue;
+
+        // From here 'seq' is the even value to restore or advance from
+        uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+        int reclaimed = 0;
+        if (seq & 1) {
+            if (!reclaim_slot(slot, seq)) continue; // another writer owns it
+            reclaimed = 1;
+            seq += 1;
+        } else if (!__atomic_compare_exchange_n(&slot->seq, &seq, seq + 1, 0,
+                                                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            continue;
+        }
+        __atomic_store_n(&slot->stamp, 0, __ATOMIC_RELAXED);
+
+        // Someone may have claimed the empty slot before we locked it. A
+        // reclaimed slot may hold a half written entry, so always overwrite.
+        current = __atomic_load_n(&slot->key, __ATOMIC_RELAXED);
+        if (!replace && !reclaimed && current != 0 && current != key) {
+            __atomic_store_n(&slot->seq, seq, __ATOMIC_RELEASE);
+            continue;
+        }
+
+        __atomic_store_n(&slot->key, key, __ATOMIC_RELAXED);
+        memcpy(&slot->entry, entry, sizeof(AnalysisEntry));
+        __atomic_store_n(&slot->stamp, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+        return 1;
+    }
+    return 0;
+}
+
+EXPORT int cache_analyze(AnalysisCache* cache, Board* board, AnalysisEntry* out) {
+    if (!board || !out) return 0;
+    if (cache_lookup(cache, board, out)) return 1;
+
+    Move moves[MAX_MOVES];
+    int color = board->current_turn;
+
+    memset(out, 0, sizeof(AnalysisEntry));
+    out->legal_moves = generate_legal_moves(board, color, moves);
+    if (is_check(board, color))
+        out->flags |= STATUS_CHECK;
+    if (out->legal_moves == 0)
+        out->flags |= (out->flags & STATUS_CHECK) ? STATUS_CHECKMATE : STATUS_STALEMATE;
+
+    cache_store(cache, board, out);
+    return 0;
+}
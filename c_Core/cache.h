@@ -0,0 +1,26 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "board.h"
+#include "move.h"
+#include <stdint.h>
+
+#define CACHE_MAGIC         0x4341504Bu  // "KPAC"
+#define CACHE_VERSION       1
+#define CACHE_DEFAULT_SLOTS (1u << 20)   // 32 MiB file
+#define CACHE_PROBES        8            // open addressing window per key
+
+// Extra bit of AnalysisEntry.flags next to the STATUS_* bits of engine.h
+#define CACHE_HAS_BEST 0x100
+
+typedef struct
+{
+    int flags;        // STATUS_* bits for the side to move, CACHE_HAS_BEST
+    int legal_moves;  // legal move count for the side to move
+    int score;        // caller defined, e.g. centipawns
+    Move best;        // valid when flags has CACHE_HAS_BEST
+} AnalysisEntry;
+
+typedef struct AnalysisCache AnalysisCache;
+
+#endif
@@ -0,0 +1,193 @@
+// c_Core/engine.c
+// Background worker that answers board queries off the caller's thread.
+#include "interface.h"
+#include "engine.h"
+#include "move.h"
+#include "status.h"
+#include <pthread.h>
+#include <string.h>
+
+typedef enum
+{
+    SLOT_FREE = 0,
+    SLOT_PENDING,
+    SLOT_RUNNING,
+    SLOT_DONE,
+    SLOT_CANCELLED
+} SlotState;
+
+typedef struct
+{
+    SlotState state;
+    Board board;            // snapshot taken at submit time
+    QueryCallback callback;
+    void* user;
+    QueryResult result;
+} QuerySlot;
+
+static QuerySlot slots[MAX_QUERIES];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static pthread_t worker;
+static int worker_started = 0;
+static int stopping = 0;
+static int next_ticket = 1;
+
+// Oldest pending slot, so queries are answered in submission order
+static QuerySlot* next_pending(void) {
+    QuerySlot* best = NULL;
+    for (int i = 0; i < MAX_QUERIES; i++) {
+        if (slots[i].state != SLOT_PENDING) continue;
+        if (!best || slots[i].result.ticket < best->result.ticket)
+            best = &slots[i];
+    }
+    return best;
+}
+
+static QuerySlot* find_ticket(int ticket) {
+    for (int i = 0; i < MAX_QUERIES; i++) {
+        if (slots[i].state != SLOT_FREE && slots[i].result.ticket == ticket)
+            return &slots[i];
+    }
+    return NULL;
+}
+
+static void run_query(QuerySlot* job) {
+    Board* board = &job->board;
+    QueryResult* r = &job->result;
+    int color = board->current_turn;
+
+    switch (r->kind) {
+        case QUERY_LEGAL_MOVES:
+            r->count = generate_piece_moves(board, r->from, r->moves);
+            break;
+
+        case QUERY_STATUS:
+            if (is_checkmate(board, color))
+                r->status = STATUS_CHECK | STATUS_CHECKMATE;
+            else if (is_stalemate(board, color))
+                r->status = STATUS_STALEMATE;
+            else if (is_check(board, color))
+                r->status = STATUS_CHECK;
+            break;
+    }
+}
+
+static void* worker_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        QuerySlot* job = next_pending();
+        while (!job && !stopping) {
+            pthread_cond_wait(&wake, &lock);
+            job = next_pending();
+        }
+        if (stopping) break;
+
+        job->state = SLOT_RUNNING;
+        pthread_mutex_unlock(&lock);
+        run_query(job);
+        pthread_mutex_lock(&lock);
+
+        if (job->state == SLOT_CANCELLED) {
+            job->state = SLOT_FREE;
+        } else if (job->callback) {
+            pthread_mutex_unlock(&lock);
+            job->callback(&job->result, job->user);
+            pthread_mutex_lock(&lock);
+            job->state = SLOT_FREE;
+        } else {
+            job->state = SLOT_DONE;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+EXPORT int submit_query(Board* board, int kind, int from, QueryCallback callback, void* user) {
+    if (!board) return -1;
+    if (kind != QUERY_LEGAL_MOVES && kind != QUERY_STATUS) return -1;
+    // on_board() alone lets 0x100 and friends through
+    if (kind == QUERY_LEGAL_MOVES && (from < 0 || from >= BOARD_SIZE || !on_board(from)))
+        return -1;
+
+    pthread_mutex_lock(&lock);
+    if (!worker_started) {
+        stopping = 0;
+        if (pthread_create(&worker, NULL, worker_main, NULL) != 0) {
+            pthread_mutex_unlock(&lock);
+            return -1;
+        }
+        worker_started = 1;
+    }
+
+    QuerySlot* slot = NULL;
+    for (int i = 0; i < MAX_QUERIES; i++) {
+        if (slots[i].state == SLOT_FREE) { slot = &slots[i]; break; }
+    }
+    if (!slot) {
+        pthread_mutex_unlock(&lock);
+        return -1; // queue full: caller should collect or cancel old tickets
+    }
+
+    memcpy(&slot->board, board, sizeof(Board));
+    slot->callback = callback;
+    slot->user = user;
+    memset(&slot->result, 0, sizeof(QueryResult));
+    slot->result.ticket = next_ticket++;
+    slot->result.kind = kind;
+    slot->result.from = from;
+    slot->result.generation = board->generation;
+    slot->state = SLOT_PENDING;
+
+    int ticket = slot->result.ticket;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    return ticket;
+}
+
+EXPORT int poll_query(int ticket, QueryResult* out) {
+    int ret = -1;
+    pthread_mutex_lock(&lock);
+    QuerySlot* slot = find_ticket(ticket);
+    if (slot && slot->state == SLOT_DONE) {
+        if (out) memcpy(out, &slot->result, sizeof(QueryResult));
+        slot->state = SLOT_FREE;
+        ret = 1;
+    } else if (slot && slot->state != SLOT_CANCELLED) {
+        ret = 0;
+    }
+    pthread_mutex_unlock(&lock);
+    return ret;
+}
+
+EXPORT void cancel_query(int ticket) {
+    pthread_mutex_lock(&lock);
+    QuerySlot* slot = find_ticket(ticket);
+    if (slot) {
+        if (slot->state == SLOT_RUNNING)
+            slot->state = SLOT_CANCELLED; // worker frees it when done
+        else if (slot->state != SLOT_CANCELLED)
+            slot->state = SLOT_FREE;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+EXPORT void shutdown_engine(void) {
+    pthread_mutex_lock(&lock);
+    if (!worker_started) {
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    stopping = 1;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+
+    pthread_join(worker, NULL);
+
+    pthread_mutex_lock(&lock);
+    for (int i = 0; i < MAX_QUERIES; i++)
+        slots[i].state = SLOT_FREE;
+    worker_started = 0;
+    pthread_mutex_unlock(&lock);
+}
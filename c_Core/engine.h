@@ -0,0 +1,35 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "board.h"
+#include "move.h"
+
+#define MAX_QUERIES 64   // requests that can be queued or awaiting collection
+
+typedef enum
+{
+    QUERY_LEGAL_MOVES = 0,  // legal moves of the piece on 'from'
+    QUERY_STATUS            // check / checkmate / stalemate for the side to move
+} QueryKind;
+
+// Bits of QueryResult.status
+#define STATUS_CHECK     1
+#define STATUS_CHECKMATE 2
+#define STATUS_STALEMATE 4
+
+typedef struct
+{
+    int ticket;
+    int kind;
+    int from;
+    unsigned int generation;  // board generation the query was submitted at
+    int status;               // STATUS_* bits for the side to move
+    int count;                // number of entries used in moves
+    Move moves[MAX_MOVES];
+} QueryResult;
+
+// Called on the worker thread once a query finishes; the slot is
+// released when the callback returns, so copy what you need
+typedef void (*QueryCallback)(const QueryResult* result, void* user);
+
+#endif
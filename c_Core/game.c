@@ -27,7 +27,7 @@ int undo_move(GameStack *stack, Board *board) {
         return 0;  // no more undo
     }
     stack->current_index--;
-    memcpy(board, &stack->history[stack->current_index].board_state, sizeof(Board));
+    load_snapshot(board, &stack->history[stack->current_index].board_state);
     return 1;
 }
 
@@ -36,6 +36,6 @@ int redo_move(GameStack *stack, Board *board) {
         return 0;  // nothing to redo
     }
     stack->current_index++;
-    memcpy(board, &stack->history[stack->current_index].board_state, sizeof(Board));
+    load_snapshot(board, &stack->history[stack->current_index].board_state);
     return 1;
 }
\ No newline at end of file
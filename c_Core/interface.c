@@ -24,21 +24,8 @@ EXPORT void display_board(Board* board) {
 
 EXPORT void get_board_state(Board* board, char* out64) {
     if (!board || !out64) { if (out64) out64[0] = '\0'; return; }
-    int idx = 0;
-    for (int r = 0; r < 8; ++r) {
-        for (int f = 0; f < 8; ++f) {
-            int sq = (r << 4) + f;
-            Piece p = board->squares[sq];
-            char ch = '.';
-            if (p.type != EMPTY) {
-                const char* pcs = " PNBRQK";
-                ch = pcs[p.type];
-                if (p.color == BLACK) ch += 32;
-            }
-            out64[idx++] = ch;
-        }
-    }
-    out64[idx] = '\0';
+    memcpy(out64, board->view, 64);
+    out64[64] = '\0';
 }
 
 /* NO is_check, is_checkmate, is_stalemate — defined in status.c */
@@ -46,6 +33,22 @@ EXPORT void get_board_state(Board* board, char* out64) {
 EXPORT int get_turn(Board* board) {
     return board ? board->current_turn : 0;
 }
+
+EXPORT const char* get_board_view(Board* board) {
+    return board ? board->view : NULL;
+}
+
+EXPORT unsigned int get_board_generation(Board* board) {
+    return board ? board->generation : 0;
+}
+
+EXPORT void restore_board(Board* board, Board* snapshot) {
+    if (board && snapshot) load_snapshot(board, snapshot);
+}
+
+EXPORT unsigned long long get_position_key(Board* board) {
+    return board ? position_key(board) : 0;
+}
 __declspec(dllexport) Board* clone_board(Board *b) {
     Board *copy = malloc(sizeof(Board));
     memcpy(copy, b, sizeof(Board));
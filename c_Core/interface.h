@@ -4,6 +4,11 @@
 
 #include <stdlib.h>
 #include "board.h"
+#include "engine.h"
+#include "mate.h"
+#include "cache.h"
+#include "archive.h"
+#include "batch.h"
 
 #ifdef _WIN32
     #define EXPORT __declspec(dllexport)
@@ -29,6 +34,77 @@ EXPORT int    is_checkmate(Board* board, int color);
 EXPORT int    is_stalemate(Board* board, int color);
 EXPORT int    get_turn(Board* board);                // returns current_turn
 
+// Zero-copy access: 64 piece letters (a1..h8, same encoding as
+// get_board_state, no NUL), valid for the board's lifetime
+EXPORT const char*  get_board_view(Board* board);
+EXPORT unsigned int get_board_generation(Board* board);
+
+// Undo/redo for callers keeping their own snapshots (e.g. clone_board):
+// copies 'snapshot' into 'board' so the view address stays fixed and
+// the generation only moves forward
+EXPORT void   restore_board(Board* board, Board* snapshot);
+
+// Background worker (engine.c): the board is copied on submit, so the
+// caller may keep moving it. submit_query returns a ticket, or -1 for
+// a full queue or bad arguments (QUERY_LEGAL_MOVES needs a real square);
+// poll_query returns 1 and fills out when done, 0 while pending, -1
+// for unknown/cancelled tickets. With a callback the result is handed
+// to it on the worker thread instead of being kept for poll_query.
+EXPORT int    submit_query(Board* board, int kind, int from,
+                           QueryCallback callback, void* user);
+EXPORT int    poll_query(int ticket, QueryResult* out);
+EXPORT void   cancel_query(int ticket);
+EXPORT void   shutdown_engine(void);
+
+// Forced mate by the side to move within max_plies (mate.c). Expands
+// at most node_budget nodes (<= 0: no limit) in a node table of at most
+// memory_limit bytes (0: MATE_DEFAULT_MEMORY). Returns the mate length
+// in plies, or MATE_NONE, MATE_UNKNOWN or MATE_INVALID. The first
+// min(length, max_line) moves of the mating line go to line.
+EXPORT int    solve_mate(Board* board, int max_plies, int node_budget,
+                         size_t memory_limit, Move* line, int max_line);
+
+// Shared on-disk analysis cache (cache.c), keyed by position_key.
+// cache_open maps 'path', creating it with 'slots' entries (0: default)
+// if missing, and returns NULL on I/O errors or a foreign file.
+// cache_lookup/cache_analyze return 1 on a hit; cache_analyze computes
+// and stores the status and move count on a miss. A slot left locked by
+// a process that died mid-store is skipped by lookups and reclaimed by
+// cache_store once it has been seen locked for a couple of seconds.
+EXPORT unsigned long long get_position_key(Board* board);
+EXPORT AnalysisCache* cache_open(const char* path, unsigned int slots);
+EXPORT void   cache_close(AnalysisCache* cache);
+EXPORT int    cache_lookup(AnalysisCache* cache, Board* board, AnalysisEntry* out);
+EXPORT int    cache_store(AnalysisCache* cache, Board* board, const AnalysisEntry* entry);
+EXPORT int    cache_analyze(AnalysisCache* cache, Board* board, AnalysisEntry* out);
+
+// Binary game archive (archive.c). Games start from the initial
+// position. archive_write_game returns 0 and skips the game if a move
+// is illegal; archive_finish writes the block index and frees the
+// writer. archive_read_game decodes the next game (after archive_seek,
+// the chosen one) into moves, returns its ply count or -1 at the end.
+EXPORT ArchiveWriter* archive_create(const char* path, int coding);
+EXPORT int    archive_write_game(ArchiveWriter* w, const Move* moves, int plies);
+EXPORT int    archive_finish(ArchiveWriter* w);
+EXPORT ArchiveReader* archive_open(const char* path);
+EXPORT int    archive_game_count(ArchiveReader* r);
+EXPORT int    archive_seek(ArchiveReader* r, int game);
+EXPORT int    archive_read_game(ArchiveReader* r, Move* moves, int max_moves,
+                                Board* final_board);
+EXPORT void   archive_close(ArchiveReader* r);
+
+// Bulk screening (batch.c). batch_load copies up to 'capacity' boards
+// into the planes. batch_check fills one BATCH_CHECK/BATCH_KING_ESCAPE
+// byte per position and returns the BatchKernel it ran; batch_classify
+// adds BATCH_CHECKMATE/BATCH_STALEMATE, re-checking boxed-in kings with
+// status.c.
+EXPORT BoardBatch* batch_create(int capacity);
+EXPORT void   batch_free(BoardBatch* batch);
+EXPORT int    batch_load(BoardBatch* batch, const Board* boards, int n);
+EXPORT void   batch_get_board(BoardBatch* batch, int index, Board* out);
+EXPORT int    batch_check(BoardBatch* batch, unsigned char* flags, int kernel);
+EXPORT void   batch_classify(BoardBatch* batch, unsigned char* flags);
+
 #ifdef __cplusplus
 }
 #endif
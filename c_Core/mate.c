@@ -0,0 +1,214 @@
+// c_Core/mate.c
+// Proof-number search for forced mates by the side to move.
+#include "interface.h"
+#include "mate.h"
+#include "move.h"
+#include "status.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PN_INF 0x3fffffffu
+
+typedef struct
+{
+    Move move;                   // move from the parent into this node
+    int parent;                  // -1 for the root
+    int first_child;             // -1 until expanded
+    unsigned short num_children;
+    unsigned short depth;        // plies from the root
+    unsigned short dist;         // plies to mate, valid once pn == 0
+    unsigned int pn, dn;
+} MateNode;
+
+typedef struct
+{
+    MateNode* nodes;
+    int used;
+    int capacity;
+    int max_plies;
+} MateTree;
+
+static unsigned int add_capped(unsigned int a, unsigned int b) {
+    return (a + b >= PN_INF) ? PN_INF : a + b;
+}
+
+// Attacker moves at even depths (OR nodes), defender at odd (AND nodes)
+static int is_or_node(const MateNode* n) { return (n->depth & 1) == 0; }
+
+// Set pn/dn of a fresh node from the position it leads to
+static void evaluate_leaf(MateTree* tree, MateNode* n, Board* board) {
+    Move moves[MAX_MOVES];
+    int count = generate_legal_moves(board, board->current_turn, moves);
+
+    if (count == 0) {
+        // Mated defender proves the node; anything else (attacker mated,
+        // stalemate) refutes it
+        int mated = is_check(board, board->current_turn);
+        if (mated && !is_or_node(n)) {
+            n->pn = 0; n->dn = PN_INF; n->dist = 0;
+        } else {
+            n->pn = PN_INF; n->dn = 0;
+        }
+    } else if (n->depth >= tree->max_plies) {
+        n->pn = PN_INF; n->dn = 0;
+    } else if (is_or_node(n)) {
+        n->pn = 1; n->dn = (unsigned int)count;
+    } else {
+        n->pn = (unsigned int)count; n->dn = 1; // many replies: harder to prove
+    }
+}
+
+static void update_node(MateTree* tree, MateNode* n) {
+    MateNode* child = &tree->nodes[n->first_child];
+    unsigned int pn, dn;
+    unsigned short dist;
+
+    if (is_or_node(n)) {
+        pn = PN_INF; dn = 0; dist = 0xFFFF;
+        for (int i = 0; i < n->num_children; i++) {
+            if (child[i].pn < pn) pn = child[i].pn;
+            dn = add_capped(dn, child[i].dn);
+            if (child[i].pn == 0 && child[i].dist < dist) dist = child[i].dist;
+        }
+    } else {
+        pn = 0; dn = PN_INF; dist = 0;
+        for (int i = 0; i < n->num_children; i++) {
+            pn = add_capped(pn, child[i].pn);
+            if (child[i].dn < dn) dn = child[i].dn;
+            if (child[i].dist > dist) dist = child[i].dist;
+        }
+    }
+    n->pn = pn;
+    n->dn = dn;
+    if (pn == 0) n->dist = (unsigned short)(dist + 1);
+}
+
+// Walk from the root to the most-proving leaf, playing its moves on 'board'
+static int select_most_proving(MateTree* tree, Board* board) {
+    int idx = 0;
+    while (tree->nodes[idx].first_child != -1) {
+        MateNode* n = &tree->nodes[idx];
+        MateNode* child = &tree->nodes[n->first_child];
+        int best = 0;
+
+        for (int i = 1; i < n->num_children; i++) {
+            if (is_or_node(n) ? child[i].pn < child[best].pn
+                              : child[i].dn < child[best].dn)
+                best = i;
+        }
+        idx = n->first_child + best;
+        apply_move(board, tree->nodes[idx].move.from, tree->nodes[idx].move.to);
+    }
+    return idx;
+}
+
+// Returns 0 when the node table is full
+static int expand(MateTree* tree, int idx, Board* board) {
+    Move moves[MAX_MOVES];
+    int count = generate_legal_moves(board, board->current_turn, moves);
+
+    if (tree->used + count > tree->capacity)
+        return 0;
+
+    int first = tree->used;
+    tree->used += count;
+    tree->nodes[idx].first_child = first;
+    tree->nodes[idx].num_children = (unsigned short)count;
+
+    for (int i = 0; i < count; i++) {
+        MateNode* child = &tree->nodes[first + i];
+        Board next;
+        memcpy(&next, board, sizeof(Board));
+        apply_move(&next, moves[i].from, moves[i].to);
+
+        child->move = moves[i];
+        child->parent = idx;
+        child->first_child = -1;
+        child->num_children = 0;
+        child->depth = tree->nodes[idx].depth + 1;
+        child->dist = 0;
+        evaluate_leaf(tree, child, &next);
+    }
+    return 1;
+}
+
+// Follow the proof tree: quickest mate for the attacker, longest defence
+static int extract_line(MateTree* tree, Move* line, int max_line) {
+    int len = 0;
+    int idx = 0;
+    while (tree->nodes[idx].first_child != -1 && len < max_line) {
+        MateNode* n = &tree->nodes[idx];
+        MateNode* child = &tree->nodes[n->first_child];
+        int best = -1;
+
+        for (int i = 0; i < n->num_children; i++) {
+            if (child[i].pn != 0) continue;
+            if (best == -1 ||
+                (is_or_node(n) ? child[i].dist < child[best].dist
+                               : child[i].dist > child[best].dist))
+                best = i;
+        }
+        if (best == -1) break;
+        idx = n->first_child + best;
+        line[len++] = tree->nodes[idx].move;
+    }
+    return len;
+}
+
+// One proof-number search with a fixed ply limit; the tree is reused
+static int search(MateTree* tree, Board* board, int* expansions_left) {
+    MateNode* root = &tree->nodes[0];
+    memset(root, 0, sizeof(MateNode));
+    root->parent = -1;
+    root->first_child = -1;
+    tree->used = 1;
+    evaluate_leaf(tree, root, board);
+
+    while (root->pn != 0 && root->dn != 0) {
+        if (*expansions_left == 0) return MATE_UNKNOWN;
+
+        Board work;
+        memcpy(&work, board, sizeof(Board));
+        int idx = select_most_proving(tree, &work);
+        if (!expand(tree, idx, &work)) return MATE_UNKNOWN;
+        if (*expansions_left > 0) (*expansions_left)--;
+
+        for (; idx != -1; idx = tree->nodes[idx].parent)
+            update_node(tree, &tree->nodes[idx]);
+    }
+    return (root->pn == 0) ? 1 : MATE_NONE;
+}
+
+EXPORT int solve_mate(Board* board, int max_plies, int node_budget,
+                      size_t memory_limit, Move* line, int max_line) {
+    if (!board || max_plies <= 0) return MATE_INVALID;
+    if (max_plies > MATE_MAX_PLIES) max_plies = MATE_MAX_PLIES;
+    if (memory_limit == 0) memory_limit = MATE_DEFAULT_MEMORY;
+
+    MateTree tree;
+    size_t capacity = memory_limit / sizeof(MateNode);
+    if (capacity > 0x7fffffff) capacity = 0x7fffffff;
+    if (capacity < 1) return MATE_UNKNOWN;
+    tree.capacity = (int)capacity;
+
+    tree.nodes = (MateNode*)malloc(capacity * sizeof(MateNode));
+    if (!tree.nodes) return MATE_UNKNOWN;
+
+    // Deepen one move at a time so the first proof is the shortest mate
+    int expansions_left = (node_budget > 0) ? node_budget : -1;
+    int result = MATE_NONE;
+    for (int limit = 1; limit <= max_plies; limit += 2) {
+        tree.max_plies = limit;
+        result = search(&tree, board, &expansions_left);
+        if (result != MATE_NONE) break;
+    }
+
+    if (result > 0) {
+        result = tree.nodes[0].dist;
+        if (line && max_line > 0)
+            extract_line(&tree, line, max_line);
+    }
+
+    free(tree.nodes);
+    return result;
+}
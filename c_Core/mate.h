@@ -0,0 +1,15 @@
+#ifndef MATE_H
+#define MATE_H
+
+#include "board.h"
+#include "move.h"
+
+#define MATE_DEFAULT_MEMORY (64u * 1024u * 1024u) // node table size when 0 is passed
+#define MATE_MAX_PLIES      250
+
+// solve_mate return values besides a positive mate length
+#define MATE_NONE     0   // proven: no forced mate within max_plies
+#define MATE_UNKNOWN -1   // node budget or memory ran out first
+#define MATE_INVALID -2   // NULL board or max_plies <= 0
+
+#endif
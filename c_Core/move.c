@@ -105,6 +105,8 @@ static bool basic_move_ok(Board *board, int from, int to) {
 }
 
 // --- Core Move Validation (with King Safety) ---
+// Legality is read off the side's KingSafety masks, so the board is
+// never touched here and may be shared by concurrent readers.
 bool is_valid_move(Board *board, int from, int to) {
     if (!on_board(from) || !on_board(to)) return false;
 
@@ -113,54 +115,135 @@ bool is_valid_move(Board *board, int from, int to) {
 
     if (!basic_move_ok(board, from, to)) return false;
 
-    // --- Handle Castling ---
-    if (moving.type == KING && abs((to & 7) - (from & 7)) == 2) {
-        int rank = from >> 4;
-        int king_side = (to & 7) > (from & 7);
-        int rook_from = rank * 16 + (king_side ? 7 : 0);
-      //  int rook_to = rank * 16 + (king_side ? 5 : 3);
-        Piece rook = board->squares[rook_from];
+    const KingSafety *safety = &board->safety[moving.color];
+    int enemy = (moving.color == WHITE) ? BLACK : WHITE;
+
+    if (moving.type == KING) {
+        // --- Handle Castling ---
+        if (abs((to & 7) - (from & 7)) == 2) {
+            int rank = from >> 4;
+            int king_side = (to & 7) > (from & 7);
+            int rook_from = rank * 16 + (king_side ? 7 : 0);
+            Piece rook = board->squares[rook_from];
+
+            if (rook.type != ROOK || rook.color != moving.color)
+                return false;
+            if (!is_clear_path(board, from, rook_from, king_side ? 1 : -1))
+                return false;
+            if (safety->checkers > 0)
+                return false;
+        }
+        // The king's own square is ignored so sliders see through it
+        return !is_square_attacked(board, to, enemy, from);
+    }
 
-        if (rook.type != ROOK || rook.color != moving.color)
-            return false;
-        if (!is_clear_path(board, from, rook_from, king_side ? 1 : -1))
-            return false;
-        if (is_check(board, moving.color))
-            return false;
+    // --- Normal move: must answer a check and stay on any pin ray ---
+    if (safety->checkers > 1)
+        return false;
+    if (safety->checkers == 1 && !safety->block[to])
+        return false;
+    if (safety->pin_ray[from] && safety->pin_ray[to] != safety->pin_ray[from])
+        return false;
 
-        // Temporarily simulate castling king movement
-        board->squares[to] = moving;
-        board->squares[from].type = EMPTY;
-        board->squares[from].color = NO_COLOR;
-        bool safe = !is_check(board, moving.color);
-        board->squares[from] = moving;
-        board->squares[to].type = EMPTY;
-        board->squares[to].color = NO_COLOR;
-        return safe;
+    return true;
+}
+
+// --- Move Generation ---
+// Steps in ascending order, so targets come out sorted for steppers
+static const int knight_steps[8]   = { -0x21, -0x1F, -0x12, -0x0E, 0x0E, 0x12, 0x1F, 0x21 };
+static const int pawn_steps[2][4] = { { 0x0F, 0x10, 0x11, 0x20 }, { -0x20, -0x11, -0x10, -0x0F } };
+// Includes the two castling targets
+static const int king_steps[10]   = { -0x11, -0x10, -0x0F, -0x02, -0x01, 0x01, 0x02, 0x0F, 0x10, 0x11 };
+static const int rook_rays[4]     = { -0x10, -0x01, 0x01, 0x10 };
+static const int bishop_rays[4]   = { -0x11, -0x0F, 0x0F, 0x11 };
+
+static int add_steps(int from, const int *steps, int n, int *targets) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        int to = from + steps[i];
+        if (on_board(to)) targets[count++] = to;
     }
+    return count;
+}
 
-    // --- Normal move: check self-check rule ---
-    Piece captured = board->squares[to];
-    board->squares[to] = moving;
-    board->squares[from].type = EMPTY;
-    board->squares[from].color = NO_COLOR;
+// Every square up to and including the first piece on each ray
+static int add_rays(Board *board, int from, const int *rays, int *targets, int count) {
+    for (int i = 0; i < 4; i++) {
+        for (int to = from + rays[i]; on_board(to); to += rays[i]) {
+            targets[count++] = to;
+            if (board->squares[to].type != EMPTY) break;
+        }
+    }
+    return count;
+}
 
-    int in_check = is_check(board, moving.color);
+// Squares the piece might reach, in ascending order; is_valid_move
+// still has the final say on each of them
+static int candidate_targets(Board *board, int from, int *targets) {
+    Piece piece = board->squares[from];
+    int count = 0;
 
-    // Undo move
-    board->squares[from] = moving;
-    board->squares[to] = captured;
+    switch (piece.type) {
+        case PAWN:
+            return add_steps(from, pawn_steps[piece.color == WHITE ? 0 : 1], 4, targets);
+        case KNIGHT:
+            return add_steps(from, knight_steps, 8, targets);
+        case KING:
+            return add_steps(from, king_steps, 10, targets);
+        case BISHOP:
+            count = add_rays(board, from, bishop_rays, targets, 0);
+            break;
+        case ROOK:
+            count = add_rays(board, from, rook_rays, targets, 0);
+            break;
+        case QUEEN:
+            count = add_rays(board, from, bishop_rays, targets, 0);
+            count = add_rays(board, from, rook_rays, targets, count);
+            break;
+        default:
+            return 0;
+    }
 
-    return !in_check;
+    // Rays interleave, so sort the (at most 27) slider targets
+    for (int i = 1; i < count; i++) {
+        int sq = targets[i], j = i;
+        for (; j > 0 && targets[j - 1] > sq; j--) targets[j] = targets[j - 1];
+        targets[j] = sq;
+    }
+    return count;
 }
 
-// --- Execute move with promotion/castling ---
-int make_move(Board *board, int from, int to) {
-    if (!is_valid_move(board, from, to))
+int generate_piece_moves(Board *board, int from, Move *moves) {
+    int targets[32];
+    int count = 0;
+    if (!on_board(from) || board->squares[from].type == EMPTY)
         return 0;
 
+    int n = candidate_targets(board, from, targets);
+    for (int i = 0; i < n; i++) {
+        if (!is_valid_move(board, from, targets[i])) continue;
+        moves[count].from = (unsigned char)from;
+        moves[count].to = (unsigned char)targets[i];
+        count++;
+    }
+    return count;
+}
+
+int generate_legal_moves(Board *board, int color, Move *moves) {
+    int count = 0;
+    for (int from = 0; from < BOARD_SIZE; from++) {
+        if (!on_board(from)) continue;
+        if (board->squares[from].color != color) continue;
+        count += generate_piece_moves(board, from, moves + count);
+    }
+    return count;
+}
+
+// --- Execute move with promotion/castling ---
+int apply_move(Board *board, int from, int to) {
     Piece moving = board->squares[from];
     int rank_to = to >> 4;
+    int flags = 0;
 
     // Castling execution
     if (moving.type == KING && abs((to & 7) - (from & 7)) == 2) {
@@ -177,7 +260,7 @@ int make_move(Board *board, int from, int to) {
         board->squares[rook_from].type = EMPTY;
         board->squares[rook_from].color = NO_COLOR;
 
-        printf("Castling performed!\n");
+        flags |= MOVE_CASTLE;
     } else {
         // Normal move
         board->squares[to] = moving;
@@ -190,9 +273,22 @@ int make_move(Board *board, int from, int to) {
         ((moving.color == WHITE && rank_to == 7) ||
          (moving.color == BLACK && rank_to == 0))) {
         board->squares[to].type = QUEEN; // Auto-promote to Queen
-        printf("Pawn promoted to Queen!\n");
+        flags |= MOVE_PROMOTION;
     }
 
     board->current_turn = (board->current_turn == WHITE) ? BLACK : WHITE;
+    refresh_board(board);
+    return flags;
+}
+
+int make_move(Board *board, int from, int to) {
+    if (!is_valid_move(board, from, to))
+        return 0;
+
+    int flags = apply_move(board, from, to);
+    if (flags & MOVE_CASTLE)
+        printf("Castling performed!\n");
+    if (flags & MOVE_PROMOTION)
+        printf("Pawn promoted to Queen!\n");
     return 1;
 }
@@ -4,7 +4,28 @@
 #include "board.h"
 #include <stdbool.h>
 
+#define MAX_MOVES 256
+
+// Bits returned by apply_move
+#define MOVE_CASTLE    1
+#define MOVE_PROMOTION 2
+
+typedef struct {
+    unsigned char from;
+    unsigned char to;
+} Move;
+
 // Check if a move from 'from' to 'to' is valid given the current board state
 bool is_valid_move(Board* board, int from, int to);
 
+// Fill 'moves' with every legal move of the piece on 'from', returns the count
+int generate_piece_moves(Board* board, int from, Move* moves);
+
+// Fill 'moves' with every legal move for 'color', sorted by from then to
+int generate_legal_moves(Board* board, int color, Move* moves);
+
+// Play an already validated move silently and switch the turn,
+// returns MOVE_* bits
+int apply_move(Board* board, int from, int to);
+
 #endif
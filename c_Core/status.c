@@ -1,8 +1,13 @@
 #include "board.h"
 #include "move.h"
+#include "status.h"
 #include <stdbool.h>
+#include <string.h>
 #include"interface.h"
 
+static const int knight_steps[8] = { 0x21, 0x1F, 0x12, 0x0E, -0x0E, -0x12, -0x1F, -0x21 };
+static const int king_steps[8]   = { 0x10, 0x11, 0x01, -0x0F, -0x10, -0x11, -0x01, 0x0F };
+
 // Helper: find the square index of the king for a color
 int find_king(Board *board, int color) {
     for (int i = 0; i < BOARD_SIZE; i++) {
@@ -14,85 +19,150 @@ int find_king(Board *board, int color) {
     return -1;
 }
 
-// Check if a given color's king is under attack
-int is_check(Board *board, int color) {
-    int king_sq = find_king(board, color);
-    if (king_sq == -1) return 0; // King missing (shouldn't happen)
+// Helper: can a piece of this type slide along 'step'? (even index = orthogonal)
+static bool slides_along(PieceType type, int dir_index) {
+    if (type == QUEEN) return true;
+    return (dir_index & 1) ? type == BISHOP : type == ROOK;
+}
 
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        if (!on_board(i)) continue;
-        Piece p = board->squares[i];
-        if (p.color != color && p.color != NO_COLOR) {
-            if (is_valid_move(board, i, king_sq)) {
-                return 1; // Opponent can attack king
+int is_square_attacked(Board *board, int sq, int by_color, int ignore_sq) {
+    // Pawns: a white pawn attacks upwards, so it sits below the square
+    int pawn_dir = (by_color == WHITE) ? -0x10 : 0x10;
+    for (int side = -1; side <= 1; side += 2) {
+        int from = sq + pawn_dir + side;
+        if (!on_board(from)) continue;
+        Piece p = board->squares[from];
+        if (p.type == PAWN && p.color == by_color)
+            return 1;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        int from = sq + knight_steps[i];
+        if (!on_board(from)) continue;
+        Piece p = board->squares[from];
+        if (p.type == KNIGHT && p.color == by_color)
+            return 1;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        int from = sq + king_steps[i];
+        if (!on_board(from)) continue;
+        Piece p = board->squares[from];
+        if (p.type == KING && p.color == by_color)
+            return 1;
+    }
+
+    // Sliders: walk out from the square until the first piece
+    for (int i = 0; i < 8; i++) {
+        int from = sq + king_steps[i];
+        while (on_board(from)) {
+            Piece p = board->squares[from];
+            if (p.type != EMPTY && from != ignore_sq) {
+                if (p.color == by_color && slides_along(p.type, i))
+                    return 1;
+                break;
             }
+            from += king_steps[i];
         }
     }
     return 0;
 }
 
-// Checkmate: king is in check and no valid move can remove the check
-int is_checkmate(Board *board, int color) {
-    if (!is_check(board, color))
-        return 0; // Not in check → can't be checkmate
-
-    for (int from = 0; from < BOARD_SIZE; from++) {
-        if (!on_board(from)) continue;
-        Piece piece = board->squares[from];
-        if (piece.color != color) continue;
+void compute_king_safety(Board *board, int color, KingSafety *out) {
+    memset(out, 0, sizeof(KingSafety));
+    out->king_sq = find_king(board, color);
+    if (out->king_sq == -1) return;
+
+    int king_sq = out->king_sq;
+    int enemy = (color == WHITE) ? BLACK : WHITE;
+
+    // Contact checks: pawns and knights can only be captured, not blocked
+    int pawn_dir = (color == WHITE) ? 0x10 : -0x10;
+    for (int side = -1; side <= 1; side += 2) {
+        int sq = king_sq + pawn_dir + side;
+        if (!on_board(sq)) continue;
+        Piece p = board->squares[sq];
+        if (p.type == PAWN && p.color == enemy) {
+            out->checkers++;
+            out->block[sq] = 1;
+        }
+    }
 
-        for (int to = 0; to < BOARD_SIZE; to++) {
-            if (!on_board(to)) continue;
-            if (!is_valid_move(board, from, to)) continue;
+    for (int i = 0; i < 8; i++) {
+        int sq = king_sq + knight_steps[i];
+        if (!on_board(sq)) continue;
+        Piece p = board->squares[sq];
+        if (p.type == KNIGHT && p.color == enemy) {
+            out->checkers++;
+            out->block[sq] = 1;
+        }
+    }
 
-            // Save original state
-            Piece captured = board->squares[to];
-            board->squares[to] = piece;
-            board->squares[from].type = EMPTY;
-            board->squares[from].color = NO_COLOR;
+    // Rays: first enemy slider is a checker; a lone friendly piece in
+    // front of one is pinned to that ray
+    for (int i = 0; i < 8; i++) {
+        int step = king_steps[i];
+        int shield = -1;
 
-            int still_in_check = is_check(board, color);
+        for (int sq = king_sq + step; on_board(sq); sq += step) {
+            Piece p = board->squares[sq];
+            if (p.type == EMPTY) continue;
 
-            // Undo move
-            board->squares[from] = piece;
-            board->squares[to] = captured;
+            if (p.color == color) {
+                if (shield != -1) break; // two own pieces: nothing pinned
+                shield = sq;
+                continue;
+            }
 
-            if (!still_in_check)
-                return 0; // Found a move that escapes check
+            if (slides_along(p.type, i)) {
+                for (int r = king_sq + step; r != sq + step; r += step) {
+                    if (shield == -1)
+                        out->block[r] = 1;
+                    else
+                        out->pin_ray[r] = (unsigned char)(i + 1);
+                }
+                if (shield == -1)
+                    out->checkers++;
+            }
+            break;
         }
     }
-    return 1; // No legal move to escape → checkmate
 }
 
-// Stalemate: not in check but no legal move exists
-int is_stalemate(Board *board, int color) {
-    if (is_check(board, color))
-        return 0; // In check → not stalemate
+// Check if a given color's king is under attack
+int is_check(Board *board, int color) {
+    if (color != WHITE && color != BLACK) return 0;
+    return board->safety[color].checkers > 0;
+}
 
+// Helper: does 'color' have at least one legal move?
+static int has_legal_move(Board *board, int color) {
     for (int from = 0; from < BOARD_SIZE; from++) {
         if (!on_board(from)) continue;
-        Piece piece = board->squares[from];
-        if (piece.color != color) continue;
+        if (board->squares[from].color != color) continue;
 
         for (int to = 0; to < BOARD_SIZE; to++) {
             if (!on_board(to)) continue;
-            if (!is_valid_move(board, from, to)) continue;
+            if (is_valid_move(board, from, to))
+                return 1;
+        }
+    }
+    return 0;
+}
 
-            // Simulate move
-            Piece captured = board->squares[to];
-            board->squares[to] = piece;
-            board->squares[from].type = EMPTY;
-            board->squares[from].color = NO_COLOR;
+// Checkmate: king is in check and no valid move can remove the check
+int is_checkmate(Board *board, int color) {
+    if (!is_check(board, color))
+        return 0; // Not in check → can't be checkmate
 
-            int still_in_check = is_check(board, color);
+    return !has_legal_move(board, color);
+}
 
-            // Undo move
-            board->squares[from] = piece;
-            board->squares[to] = captured;
+// Stalemate: not in check but no legal move exists
+int is_stalemate(Board *board, int color) {
+    if (color != WHITE && color != BLACK) return 0; // safety[] has two entries
+    if (is_check(board, color))
+        return 0; // In check → not stalemate
 
-            if (!still_in_check)
-                return 0; // At least one legal move available
-        }
-    }
-    return 1; // No moves and not in check → stalemate
+    return !has_legal_move(board, color);
 }
@@ -8,4 +8,13 @@ int is_check(Board *board, int color);
 int is_checkmate(Board *board, int color);
 int is_stalemate(Board *board, int color);
 
+// Is 'sq' attacked by any piece of 'by_color'? 'ignore_sq' is treated as
+// empty (pass the moving king's square so it cannot hide behind itself),
+// or -1 to ignore nothing.
+int is_square_attacked(Board *board, int sq, int by_color, int ignore_sq);
+
+// Fill 'out' with the checkers, check-blocking squares and pin rays of
+// 'color's king. Reads the board only.
+void compute_king_safety(Board *board, int color, KingSafety *out);
+
 #endif
@@ -43,11 +43,48 @@ chess_lib.is_stalemate.restype = c_int
 chess_lib.get_turn.argtypes = [BoardPtr]
 chess_lib.get_turn.restype = c_int
 
+chess_lib.get_board_view.argtypes = [BoardPtr]
+chess_lib.get_board_view.restype = c_void_p
+
+chess_lib.get_board_generation.argtypes = [BoardPtr]
+chess_lib.get_board_generation.restype = c_uint
+
+chess_lib.restore_board.argtypes = [BoardPtr, BoardPtr]
+
 chess_lib.clone_board.argtypes = [BoardPtr]
 chess_lib.clone_board.restype = BoardPtr
 
 chess_lib.free_board_clone.argtypes = [BoardPtr]
 
+# -------------------- ENGINE WORKER ----------------
+QUERY_LEGAL_MOVES = 0
+QUERY_STATUS = 1
+
+STATUS_CHECK = 1
+STATUS_CHECKMATE = 2
+STATUS_STALEMATE = 4
+
+MAX_MOVES = 256
+
+class Move(Structure):
+    _fields_ = [("from_sq", c_ubyte), ("to_sq", c_ubyte)]
+
+class QueryResult(Structure):
+    _fields_ = [("ticket", c_int), ("kind", c_int), ("from_sq", c_int),
+                ("generation", c_uint), ("status", c_int), ("count", c_int),
+                ("moves", Move * MAX_MOVES)]
+
+QueryCallback = CFUNCTYPE(None, POINTER(QueryResult), c_void_p)
+
+chess_lib.submit_query.argtypes = [BoardPtr, c_int, c_int, QueryCallback, c_void_p]
+chess_lib.submit_query.restype = c_int
+
+chess_lib.poll_query.argtypes = [c_int, POINTER(QueryResult)]
+chess_lib.poll_query.restype = c_int
+
+chess_lib.cancel_query.argtypes = [c_int]
+chess_lib.shutdown_engine.argtypes = []
+
 # -------------------- PIECE MAPPING / ASSETS ----------------
 _piece_map = {
     'K': 'wK', 'Q': 'wQ', 'R': 'wR', 'B': 'wB', 'N': 'wN', 'P': 'wP',
@@ -79,28 +116,51 @@ for c in "wb":
             img = pygame.image.load(img_path).convert_alpha()
             PIECES[f"{c}{p}"] = pygame.transform.smoothscale(img, (SQUARE, SQUARE))
 
-# -------------------- Convert C-board 64 char string to Python matrix ----------------
-def c_board_to_python(board_ptr):
-    buf = (c_char * 65)()
-    chess_lib.get_board_state(board_ptr, buf)
-    s = buf.raw[:64].decode("ascii")
-    return [[_piece_map[s[r * 8 + f]] for f in range(8)] for r in range(8)]
+_byte_piece_map = {ord(k): v for k, v in _piece_map.items()}
+
+# -------------------- Live view of the C board ----------------
+class BoardView:
+    """Maps the board's 64-byte square array in place and rebuilds the
+    Python matrix only when the C side bumps its generation counter."""
+
+    def __init__(self, board_ptr):
+        self.board_ptr = board_ptr
+        addr = chess_lib.get_board_view(board_ptr)
+        self.squares = memoryview((c_ubyte * 64).from_address(addr))
+        self.generation = None
+        self.matrix = None
+
+    def to_python(self):
+        gen = chess_lib.get_board_generation(self.board_ptr)
+        if gen != self.generation:
+            sq = self.squares
+            self.matrix = [[_byte_piece_map[sq[r * 8 + f]] for f in range(8)] for r in range(8)]
+            self.generation = gen
+        return self.matrix
 
 # -------------------- Helpers -------------------
 def on_board(sq): return (sq & 0x88) == 0
 
-def get_legal_moves(board_ptr, from_sq):
-    moves = []
-    temp = chess_lib.clone_board(board_ptr)
-    for to_sq in range(128):
-        if not on_board(to_sq):
-            continue
-        if chess_lib.make_move(temp, from_sq, to_sq):
-            moves.append(to_sq)
-            chess_lib.free_board_clone(temp)
-            temp = chess_lib.clone_board(board_ptr)
-    chess_lib.free_board_clone(temp)
-    return moves
+class EngineQuery:
+    """One request to the C worker thread; the frame loop polls it."""
+
+    def __init__(self, board_ptr, kind, from_sq=0):
+        self.ticket = chess_lib.submit_query(board_ptr, kind, from_sq, QueryCallback(), None)
+
+    def poll(self):
+        """Returns the QueryResult once the worker is done, else None."""
+        if self.ticket < 0:
+            return None
+        res = QueryResult()
+        if chess_lib.poll_query(self.ticket, byref(res)) != 1:
+            return None
+        self.ticket = -1
+        return res
+
+    def cancel(self):
+        if self.ticket >= 0:
+            chess_lib.cancel_query(self.ticket)
+            self.ticket = -1
 
 def rc_to_board_index(r, f): return (r << 4) | f
 def board_index_to_rc(sq): return (sq >> 4), (sq & 7)
@@ -163,33 +223,48 @@ def main():
     clock = pygame.time.Clock()
 
     board_ptr = chess_lib.create_board()
+    view = BoardView(board_ptr)
 
     undo_stack = []
     redo_stack = []
 
-    def save_state():
+    def try_move(from_sq, to_sq):
+        # Snapshot first, but only touch history once the move is played,
+        # so an illegal drop keeps the redo stack intact
         clone = chess_lib.clone_board(board_ptr)
+        if not chess_lib.make_move(board_ptr, from_sq, to_sq):
+            chess_lib.free_board_clone(clone)
+            return False
         undo_stack.append(clone)
+        for snapshot in redo_stack:
+            chess_lib.free_board_clone(snapshot)
         redo_stack.clear()
+        return True
 
+    # The live board never moves, so the mapped view and its generation
+    # stay valid; history is kept as clones copied back into it
     def undo():
-        nonlocal board_ptr
         if not undo_stack:
             return
         redo_stack.append(chess_lib.clone_board(board_ptr))
-        chess_lib.free_board(board_ptr)
-        board_ptr = undo_stack.pop()
+        snapshot = undo_stack.pop()
+        chess_lib.restore_board(board_ptr, snapshot)
+        chess_lib.free_board_clone(snapshot)
 
     def redo():
-        nonlocal board_ptr
         if not redo_stack:
             return
         undo_stack.append(chess_lib.clone_board(board_ptr))
-        chess_lib.free_board(board_ptr)
-        board_ptr = redo_stack.pop()
+        snapshot = redo_stack.pop()
+        chess_lib.restore_board(board_ptr, snapshot)
+        chess_lib.free_board_clone(snapshot)
 
     selected = None
     legal_moves = []
+    moves_query = None
+    status_query = None
+    status_key = None
+    status = 0
     dragging = False
     dragging_piece = None
     last_move = None
@@ -198,15 +273,35 @@ def main():
 
     while True:
         clock.tick(FPS)
-        py_board = c_board_to_python(board_ptr)
+        py_board = view.to_python()
         turn = chess_lib.get_turn(board_ptr)
         turn_color = "w" if turn == 0 else "b"
 
+        # Ask the worker about each new position; keep drawing meanwhile
+        key = view.generation
+        if key != status_key:
+            if status_query:
+                status_query.cancel()
+            status_query = EngineQuery(board_ptr, QUERY_STATUS)
+            status_key = key
+            status = 0
+        if status_query:
+            res = status_query.poll()
+            if res:
+                status = res.status
+                status_query = None
+
+        if moves_query:
+            res = moves_query.poll()
+            if res:
+                legal_moves = [res.moves[i].to_sq for i in range(res.count)]
+                moves_query = None
+
         if not game_over:
-            if chess_lib.is_checkmate(board_ptr, turn):
+            if status & STATUS_CHECKMATE:
                 end_text = "CHECKMATE!"
                 game_over = True
-            elif chess_lib.is_stalemate(board_ptr, turn):
+            elif status & STATUS_STALEMATE:
                 end_text = "STALEMATE!"
                 game_over = True
 
@@ -217,15 +312,16 @@ def main():
         if game_over:
             draw_game_over(end_text)
         else:
-            status = ("White" if turn_color == "w" else "Black") + " to move"
-            if chess_lib.is_check(board_ptr, turn):
-                status += " — CHECK!"
-            draw_status_text(status)
+            text = ("White" if turn_color == "w" else "Black") + " to move"
+            if status & STATUS_CHECK:
+                text += " — CHECK!"
+            draw_status_text(text)
 
         pygame.display.flip()
 
         for ev in pygame.event.get():
             if ev.type == pygame.QUIT:
+                chess_lib.shutdown_engine()
                 chess_lib.free_board(board_ptr)
                 pygame.quit()
                 return
@@ -249,7 +345,10 @@ def main():
                     continue
                 selected = (r, f)
                 from_sq = rc_to_board_index(r, f)
-                legal_moves = get_legal_moves(board_ptr, from_sq)
+                if moves_query:
+                    moves_query.cancel()
+                moves_query = EngineQuery(board_ptr, QUERY_LEGAL_MOVES, from_sq)
+                legal_moves = []
                 dragging = True
                 dragging_piece = {"key": piece, "pos": (r, f)}
 
@@ -259,10 +358,13 @@ def main():
                 if (0 <= r2 < 8 and 0 <= f2 < 8):
                     to_sq = rc_to_board_index(r2, f2)
                     from_sq = rc_to_board_index(selected[0], selected[1])
-                    if to_sq in legal_moves:
-                        save_state()
-                        if chess_lib.make_move(board_ptr, from_sq, to_sq):
+                    # make_move validates on its own if the worker is still busy
+                    if to_sq in legal_moves or (moves_query and to_sq != from_sq):
+                        if try_move(from_sq, to_sq):
                             last_move = (from_sq, to_sq)
+                if moves_query:
+                    moves_query.cancel()
+                    moves_query = None
                 selected = None
                 legal_moves = []
                 dragging = False